@@ -0,0 +1,231 @@
+/*
+***************************************************************************************************
+* Project:  ADC
+* Filename: ADC.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is an ADC driver for the ATtiny841.
+*              The ADC runs in auto trigger mode, free-running or started by Timer0 at a fixed
+*              sample rate, and never waits in the main loop. The ISR adds 4^n samples of a channel
+*              and shifts the sum right by n (decimation), which gives 10 + n bits if the input
+*              has at least 1 LSB of noise. Then it goes on to the next channel of the list.
+*
+*              After a complete scan the results bank is swapped, ADC_get and ADC_get_all always
+*              read the bank of the last complete scan while the ISR fills the other one.
+*
+*              Free-running: the next conversion starts when the ISR is entered, with the channel
+*              that was set before. So the first sample after a channel change still belongs to
+*              the old channel and is dropped (one per channel and scan).
+*
+***************************************************************************************************
+*/
+
+#include "ADC.h"
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static const unsigned char   ADC_channels[ADC_CHANNEL_COUNT] = ADC_CHANNEL_LIST;
+
+/* Results of the last complete scan (bank ADC_front) and the running one */
+static volatile unsigned int  ADC_results[2][ADC_CHANNEL_COUNT];
+static volatile unsigned char ADC_front = 0;
+static volatile unsigned char ADC_scan_count = 0;  /* Complete scans, readers check it for a swap */
+
+/* Used by the ISR only */
+static ADC_sum       ADC_accumulator;
+static unsigned int  ADC_remaining;                /* Samples left for the current result */
+static unsigned char ADC_index;                    /* Channel of the current result        */
+static unsigned char ADC_converting;               /* Channel of the running conversion    */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: ADC_init
+* ------------------
+*   Initializes the ADC (power on in PRR, reference, first channel) and starts the conversions.
+*   With ADC_TRIGGER_TIMER0 Timer0 runs in CTC mode and starts a conversion at every compare
+*   match A. The results are 0 until the first scan is complete, see ADC_scans.
+*
+***************************************************************************************************
+*/
+void ADC_init(void)
+{
+    PRR &= ~(1<<PRADC);
+    
+    DIDR0 |= ADC_DIDR0;
+    DIDR1 |= ADC_DIDR1;
+    
+    ADC_accumulator = 0;
+    ADC_remaining = ADC_SAMPLES;
+    ADC_index = 0;
+    ADC_converting = 0;
+    
+    ADMUXA = ADC_channels[0];
+    ADMUXB = (ADC_REFERENCE<<REFS0);                    /* Gain 1 */
+    ADCSRB = (ADC_TRIGGER<<ADTS0);                      /* Right adjusted */
+    
+#if ADC_TRIGGER == ADC_TRIGGER_TIMER0
+    PRR &= ~(1<<PRTIM0);
+    TCCR0A = (1<<WGM01);                                /* CTC, TOP = OCR0A */
+    OCR0A = ADC_TIMER0_TOP;
+    TIFR0 = (1<<OCF0A);
+    TCCR0B = (1<<CS01)|(1<<CS00);                       /* F_CPU / 64 */
+    
+    ADCSRA = (1<<ADEN)|(1<<ADATE)|(1<<ADIF)|(1<<ADIE)|(ADC_ADPS<<ADPS0);
+#else
+    ADCSRA = (1<<ADEN)|(1<<ADSC)|(1<<ADATE)|(1<<ADIF)|(1<<ADIE)|(ADC_ADPS<<ADPS0);
+#endif
+    
+    sei();
+}
+
+/*
+***************************************************************************************************
+* Function: ADC_disable
+* ---------------------
+*   Stop the conversions and turn the ADC off (also in PRR), with ADC_TRIGGER_TIMER0 Timer0 too.
+*   The last results stay readable, ADC_init starts again.
+*
+***************************************************************************************************
+*/
+void ADC_disable(void)
+{
+    ADCSRA = 0;
+    PRR |= (1<<PRADC);
+    
+#if ADC_TRIGGER == ADC_TRIGGER_TIMER0
+    TCCR0B = 0;
+    PRR |= (1<<PRTIM0);
+#endif
+}
+
+/*
+***************************************************************************************************
+* Function: ADC_get
+* -----------------
+*   Read the result of one channel from the last complete scan. Does not wait for the ADC.
+*
+*   index: position of the channel in ADC_CHANNEL_LIST (0...ADC_CHANNEL_COUNT-1)
+*
+*   returns: result with 10 + ADC_OVERSAMPLING_BITS bits
+*
+***************************************************************************************************
+*/
+unsigned int ADC_get(unsigned char index)
+{
+    unsigned char scans;
+    unsigned int  value;
+    
+    
+    do {                                                /* Read again if the banks were swapped */
+        scans = ADC_scan_count;
+        value = ADC_results[ADC_front][index];
+    } while (scans != ADC_scan_count);
+    
+    return value;
+}
+
+/*
+***************************************************************************************************
+* Function: ADC_get_all
+* ---------------------
+*   Copy the results of the last complete scan, all from the same scan. Does not wait for the ADC.
+*
+*   results: array of ADC_CHANNEL_COUNT values, in the order of ADC_CHANNEL_LIST
+*
+*   returns: number of the scan (see ADC_scans)
+*
+***************************************************************************************************
+*/
+unsigned char ADC_get_all(unsigned int *results)
+{
+    unsigned char scans;
+    unsigned char bank;
+    unsigned char i;
+    
+    
+    do {                                                /* Copy again if the banks were swapped */
+        scans = ADC_scan_count;
+        bank = ADC_front;
+        for (i = 0; i < ADC_CHANNEL_COUNT; ++i) {
+            results[i] = ADC_results[bank][i];
+        }
+    } while (scans != ADC_scan_count);
+    
+    return scans;
+}
+
+/*
+***************************************************************************************************
+* Function: ADC_scans
+* -------------------
+*   returns: number of complete scans (wraps at 256). New results if it differs from last time.
+*
+***************************************************************************************************
+*/
+unsigned char ADC_scans(void)
+{
+    return ADC_scan_count;
+}
+
+/*
+***************************************************************************************************
+* Interrupt vector for ADC Conversion Complete
+* --------------------------------------------
+*   Conversion complete. Add the sample, store the decimated result after ADC_SAMPLES samples
+*   and select the next channel. The bank is swapped after the last channel of the list.
+*
+***************************************************************************************************
+*/
+ISR (ADC_vect)
+{
+    unsigned int  sample = ADC;
+    unsigned char channel = ADC_converting;
+    unsigned char back;
+    
+    
+#if ADC_TRIGGER == ADC_TRIGGER_FREE_RUNNING
+    ADC_converting = ADC_index;                         /* Started now with the channel set before */
+#else
+    TIFR0 = (1<<OCF0A);                                 /* The next compare match triggers again */
+#endif
+    
+    if (channel != ADC_index) {
+        return;                                         /* Sample of the previous channel */
+    }
+    
+    ADC_accumulator += sample;
+    if (--ADC_remaining) {
+        return;
+    }
+    
+    back = ADC_front ^ 1;
+    ADC_results[back][ADC_index] = (unsigned int)((ADC_accumulator + ADC_ROUNDING) >> ADC_OVERSAMPLING_BITS);
+    ADC_accumulator = 0;
+    ADC_remaining = ADC_SAMPLES;
+    
+    if (++ADC_index == ADC_CHANNEL_COUNT) {
+        ADC_index = 0;
+        ADC_front = back;
+        ADC_scan_count++;
+    }
+    
+#if ADC_CHANNEL_COUNT > 1
+    ADMUXA = ADC_channels[ADC_index];
+#endif
+#if ADC_TRIGGER == ADC_TRIGGER_TIMER0
+    ADC_converting = ADC_index;                         /* The next trigger uses the new channel */
+#endif
+}
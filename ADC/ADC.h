@@ -0,0 +1,134 @@
+/*
+***************************************************************************************************
+* Project:  ADC
+* Filename: ADC.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for ADC.c
+*
+***************************************************************************************************
+*/
+
+
+#ifndef ADC_H_
+#define ADC_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define F_CPU   8000000UL           /* F_osc=8MHz & CKDIV=1 -> 8MHz / 1 = 8MHz */
+
+#define ADC_PRESCALER           64          /* ADC clock F_CPU / 2...128, 50...200 kHz for 10 bit  */
+#define ADC_REFERENCE           0           /* REFS2..0: 0 -> VCC, 1 -> AREF pin, 2 -> 1.1V ...      */
+
+#define ADC_TRIGGER             ADC_TRIGGER_FREE_RUNNING
+#define ADC_SAMPLE_RATE         1000UL      /* Samples/s with ADC_TRIGGER_TIMER0 (Timer0, F_CPU/64) */
+
+/* Oversampling: 4^n samples per result, result has 10 + n bits (needs some noise on the input).
+ * n = 0...3 uses a 16 bit sum, 4...6 a 32 bit sum in the ISR. */
+#define ADC_OVERSAMPLING_BITS   2
+
+/* Scanned channels (MUX5..0 of ADMUXA), one result per channel and scan */
+#define ADC_CHANNEL_LIST        { 0, 1, 2 }
+#define ADC_CHANNEL_COUNT       3
+
+/* Digital input buffers to turn off on the analog pins (bit set -> off) */
+#define ADC_DIDR0               0b00000111  /* PA7...PA0 */
+#define ADC_DIDR1               0b00000000  /* PB3...PB0 */
+
+/* End of configuration options. Change followings only if you know what you are doing.          */
+/* ********************************************************************************************* */
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define ADC_TRIGGER_FREE_RUNNING    0       /* ADTS 000, next conversion starts right away          */
+#define ADC_TRIGGER_TIMER0          3       /* ADTS 011, Timer0 Compare Match A at ADC_SAMPLE_RATE  */
+
+#define ADC_SAMPLES             (1U << (2 * ADC_OVERSAMPLING_BITS))     /* Samples per result */
+#define ADC_ROUNDING            ((1U << ADC_OVERSAMPLING_BITS) >> 1)    /* 0.5 LSB of the result */
+
+/* ADPS2..0 of the prescaler */
+#if ADC_PRESCALER == 2
+#define ADC_ADPS                1
+#elif ADC_PRESCALER == 4
+#define ADC_ADPS                2
+#elif ADC_PRESCALER == 8
+#define ADC_ADPS                3
+#elif ADC_PRESCALER == 16
+#define ADC_ADPS                4
+#elif ADC_PRESCALER == 32
+#define ADC_ADPS                5
+#elif ADC_PRESCALER == 64
+#define ADC_ADPS                6
+#elif ADC_PRESCALER == 128
+#define ADC_ADPS                7
+#else
+#error "ADC_PRESCALER must be 2, 4, 8, 16, 32, 64 or 128"
+#endif
+
+#define ADC_TIMER0_TOP          (F_CPU / (64UL * ADC_SAMPLE_RATE) - 1)
+
+/* Configuration checks */
+#if (F_CPU / ADC_PRESCALER > 200000UL) || (F_CPU / ADC_PRESCALER < 50000UL)
+#warning "ADC clock is outside of 50...200 kHz, the resolution is less than 10 bit"
+#endif
+#if (ADC_OVERSAMPLING_BITS < 0) || (ADC_OVERSAMPLING_BITS > 6)
+#error "ADC_OVERSAMPLING_BITS must be 0...6"
+#endif
+#if (ADC_CHANNEL_COUNT < 1) || (ADC_CHANNEL_COUNT > 16)
+#error "ADC_CHANNEL_COUNT must be 1...16"
+#endif
+#if (ADC_TRIGGER != ADC_TRIGGER_FREE_RUNNING) && (ADC_TRIGGER != ADC_TRIGGER_TIMER0)
+#error "ADC_TRIGGER must be ADC_TRIGGER_FREE_RUNNING or ADC_TRIGGER_TIMER0"
+#endif
+#if (ADC_TRIGGER == ADC_TRIGGER_TIMER0) && ((ADC_TIMER0_TOP < 1) || (ADC_TIMER0_TOP > 255))
+#error "ADC_SAMPLE_RATE is out of range for F_CPU"
+#endif
+#if (ADC_TRIGGER == ADC_TRIGGER_TIMER0) && (ADC_SAMPLE_RATE > F_CPU / ADC_PRESCALER / 14)
+#error "ADC_SAMPLE_RATE is faster than a conversion (13.5 ADC clocks)"
+#endif
+#if (ADC_TRIGGER == ADC_TRIGGER_TIMER0) && defined(TICK_H_)
+#error "ADC_TRIGGER_TIMER0 and Tick.c of the Scheduler both use Timer0, use ADC_TRIGGER_FREE_RUNNING"
+#endif
+
+/* Sum of the samples of one result, no multiplier needed: 4^n samples of 10 bit */
+#if ADC_OVERSAMPLING_BITS <= 3
+typedef unsigned int  ADC_sum;
+#else
+typedef unsigned long ADC_sum;
+#endif
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdbool.h>
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+void ADC_init(void);
+void ADC_disable(void);
+unsigned int ADC_get(unsigned char index);
+unsigned char ADC_get_all(unsigned int *results);
+unsigned char ADC_scans(void);
+
+
+
+#endif /* ADC_H_ */
@@ -0,0 +1,96 @@
+/*
+***************************************************************************************************
+* Project:  ADC
+* Filename: main.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a test program for the ADC Driver.
+*              ADC0...ADC2 (PA0...PA2) are scanned in the background with 12 bit results.
+*              Have a look at the Main loop for an example.
+*
+***************************************************************************************************
+*/
+
+#include "main.h"
+#include "ADC.h"
+
+
+/*
+***************************************************************************************************
+**                                             MAIN
+***************************************************************************************************
+*/
+int main(void)
+{
+    /* Local variables */
+    unsigned int  results[ADC_CHANNEL_COUNT];   /* for debugging */
+    unsigned int  maximum = 0;                  /* for debugging */
+    unsigned char scans = 0;
+    unsigned char i;
+    
+    /* Initializations */
+    ATtiny841_board_init();
+    ADC_init();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    
+    
+    /* Main loop */
+    while(1)
+    {
+        /* New scan? Reading never waits for a conversion */
+        if (ADC_scans() != scans) {
+            scans = ADC_get_all(results);
+            for (i = 0; i < ADC_CHANNEL_COUNT; ++i) {
+                if (results[i] > maximum) {
+                    maximum = results[i];       /* for debugging, 0...4095 */
+                }
+            }
+        }
+        
+        /* Single channel, e.g. to control something */
+        if (ADC_get(0) > (1U << (9 + ADC_OVERSAMPLING_BITS))) {
+            PORTB |= (1<<PB0);               /* ADC0 above VCC / 2 */
+        } else {
+            PORTB &= ~(1<<PB0);
+        }
+        
+        sleep_mode();                           /* Until the next ADC interrupt */
+        
+    } /* while(1) */
+} /* Main */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: ATtiny841_board_init
+* ------------------------------
+*   Initializes the ports of the ATtiny841-board
+*   PA0...PA2 are analog inputs (no pull-ups), their digital input buffers are turned off by
+*   ADC_init
+*   All peripherals are turned off, the drivers turn on what they use
+*
+***************************************************************************************************
+*/
+void ATtiny841_board_init(void)
+{
+    /* 0 -> input | 1 -> output */
+            
+    /* Bit:  76543210 */
+    DDRA = 0b11111000;
+    DDRB = 0b11111111;
+            
+    PORTA = 0b00000000;
+    PORTB = 0b00000000;
+    
+    PRR = (1<<PRTWI)|(1<<PRUSART1)|(1<<PRUSART0)|(1<<PRSPI)|(1<<PRTIM2)|(1<<PRTIM1)|(1<<PRTIM0)|(1<<PRADC);
+    ACSR0A = (1<<ACD0);                 /* Analog comparators off */
+    ACSR1A = (1<<ACD1);
+}
@@ -0,0 +1,145 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: AT24C32.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a driver for the EEPROM AT24C32 (4 KByte, 32 byte pages).
+*              Writes are split into page writes. Instead of waiting the worst-case write cycle
+*              time (10ms), the EEPROM is polled until it acknowledges its address again
+*              (acknowledge polling). The poll is done before the next access, so the write
+*              cycle of the last page runs while the application goes on.
+*
+***************************************************************************************************
+*/
+
+#include "AT24C32.h"
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: AT24C32_poll
+* ----------------------
+*   Poll the EEPROM once, for a task that waits for the write cycle without blocking
+*   (TASK_WAIT_UNTIL(task, (status = AT24C32_poll()) != I2C_ERROR_NACK)).
+*
+*   returns: I2C_OK (EEPROM ready), I2C_ERROR_NACK (internal write cycle running, no
+*            acknowledge of the address) or an error of the bus
+*
+***************************************************************************************************
+*/
+I2C_status AT24C32_poll(void)
+{
+    return I2C_write_byte(true, true, (AT24C32_ADDRESS | I2C_WRITE));     /* Start condition, slave address, stop condition */
+}
+
+/*
+***************************************************************************************************
+* Function: AT24C32_wait_ready
+* ----------------------------
+*   Wait until the EEPROM has finished its internal write cycle. The EEPROM does not acknowledge
+*   its address while it is busy.
+*
+*   returns: I2C_OK (EEPROM ready), I2C_ERROR_NACK (no acknowledge after AT24C32_POLL_LIMIT
+*            polls) or an error of the bus
+*
+***************************************************************************************************
+*/
+I2C_status AT24C32_wait_ready(void)
+{
+    unsigned int poll;
+    I2C_status   status = I2C_ERROR_NACK;
+    
+    
+    for (poll = 0; (poll < AT24C32_POLL_LIMIT) && (status == I2C_ERROR_NACK); ++poll) {
+        status = I2C_write_byte(true, true, (AT24C32_ADDRESS | I2C_WRITE));   /* Start condition, slave address, stop condition */
+    }
+    return status;
+}
+
+/*
+***************************************************************************************************
+* Function: AT24C32_write
+* -----------------------
+*   Write bytes to the EEPROM. The data is split at page boundaries, every part is written with
+*   one page write. Returns after the last page write was started.
+*
+*   address: first EEPROM address (0...4095)
+*   data:    bytes to write
+*   length:  number of bytes
+*
+*   returns: I2C_OK (write successful), I2C_ERROR_NACK (also for an address out of range) or
+*            an error of the bus
+*
+***************************************************************************************************
+*/
+I2C_status AT24C32_write(unsigned int address, const unsigned char *data, unsigned int length)
+{
+    unsigned int chunk;
+    I2C_status   status;
+    
+    
+    if ((address >= AT24C32_SIZE) || (length > (AT24C32_SIZE - address))) {
+        return I2C_ERROR_NACK;
+    }
+    
+    while (length > 0) {
+        chunk = AT24C32_PAGE_SIZE - (address & (AT24C32_PAGE_SIZE - 1));     /* Bytes left in this page */
+        if (chunk > length) {
+            chunk = length;
+        }
+        
+        status = AT24C32_wait_ready();
+        if (status == I2C_OK) {
+            status = I2C_write_burst_16bit_addr(AT24C32_ADDRESS, (unsigned char)(address >> 8), (unsigned char)address, data, chunk);
+        }
+        if (status != I2C_OK) {
+            return status;
+        }
+        
+        address += chunk;
+        data    += chunk;
+        length  -= chunk;
+    }
+    return I2C_OK;
+}
+
+/*
+***************************************************************************************************
+* Function: AT24C32_read
+* ----------------------
+*   Read bytes from the EEPROM in one sequential read.
+*
+*   address: first EEPROM address (0...4095)
+*   data:    destination
+*   length:  number of bytes (at least 1)
+*
+*   returns: I2C_OK (read successful), I2C_ERROR_NACK (also for an address out of range) or
+*            an error of the bus
+*
+***************************************************************************************************
+*/
+I2C_status AT24C32_read(unsigned int address, unsigned char *data, unsigned int length)
+{
+    I2C_status status;
+    
+    
+    if ((address >= AT24C32_SIZE) || (length > (AT24C32_SIZE - address))) {
+        return I2C_ERROR_NACK;
+    }
+    
+    status = AT24C32_wait_ready();
+    if (status != I2C_OK) {
+        return status;
+    }
+    
+    return I2C_read_burst_16bit_addr(AT24C32_ADDRESS, (unsigned char)(address >> 8), (unsigned char)address, data, length);
+}
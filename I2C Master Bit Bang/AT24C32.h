@@ -0,0 +1,60 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: AT24C32.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for AT24C32.c
+*
+***************************************************************************************************
+*/
+
+#ifndef AT24C32_H_
+#define AT24C32_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define AT24C32_ADDRESS     0xA0        /* 8-bit address of EEPROM (A2..A0 = 0) */
+
+#define AT24C32_POLL_LIMIT  200         /* Max. address polls while a write cycle is running, each */
+                                        /* poll takes about 10 bit times (> 10ms at 100kHz)         */
+
+/* End of configuration options. Do not change followings without care.                          */
+/*************************************************************************************************/
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define AT24C32_SIZE        4096        /* Bytes */
+#define AT24C32_PAGE_SIZE   32          /* Bytes, a page write must not cross a page boundary */
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include "I2C_Master_Bit_Bang_Driver.h"
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+I2C_status AT24C32_poll(void);
+I2C_status AT24C32_wait_ready(void);
+I2C_status AT24C32_write(unsigned int address, const unsigned char *data, unsigned int length);
+I2C_status AT24C32_read(unsigned int address, unsigned char *data, unsigned int length);
+
+
+#endif /* AT24C32_H_ */
@@ -0,0 +1,333 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: DS1307.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a driver for the RTC DS1307.
+*              The 7 time registers are read and written in one burst. The RTC outputs 1Hz on
+*              SQW/OUT, every falling edge (the seconds update of the RTC) is counted by a pin
+*              change interrupt. DS1307_get_time advances a local copy of the time by these
+*              seconds and only reads the RTC again every DS1307_RESYNC_SECONDS.
+*
+***************************************************************************************************
+*/
+
+#include "DS1307.h"
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static DS1307_time            DS1307_local;                 /* Time at the last counted second */
+static volatile unsigned int  DS1307_ticks = 0;             /* Seconds not yet added to DS1307_local, */
+                                                            /* stops at 0xFFFF                        */
+static unsigned int           DS1307_since_sync = 0;        /* Seconds since the last read of the RTC */
+static bool                   DS1307_synced = false;
+
+static const unsigned char DS1307_days_in_month[12] PROGMEM = {
+    31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+};
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: DS1307_read_time
+* --------------------------
+*   Read the time from the RTC (one burst read of the 7 time registers).
+*
+*   time: destination
+*
+*   returns: result of the I2C transaction
+*
+***************************************************************************************************
+*/
+I2C_status DS1307_read_time(DS1307_time *time)
+{
+    unsigned char raw[7];
+    I2C_status    status;
+    
+    
+    status = I2C_read_burst(DS1307_ADDRESS, DS1307_SECONDS, raw, sizeof(raw));
+    if (status != I2C_OK) {
+        return status;
+    }
+    
+    time->seconds = BCD_to_decimal(raw[0] & ~DS1307_CH);
+    time->minutes = BCD_to_decimal(raw[1]);
+    time->hours   = BCD_to_decimal(raw[2] & 0x3F);          /* 24-hour mode */
+    time->day     = raw[3];
+    time->date    = BCD_to_decimal(raw[4]);
+    time->month   = BCD_to_decimal(raw[5]);
+    time->year    = BCD_to_decimal(raw[6]);
+    
+    return I2C_OK;
+}
+
+/*
+***************************************************************************************************
+* Function: DS1307_clear_ticks
+* ----------------------------
+*   Drop the counted seconds before the time is read from or written to the RTC. Seconds that
+*   start during the transaction are counted from then on, none is lost.
+*
+*   returns: the number of seconds counted since the last clear
+*
+***************************************************************************************************
+*/
+static unsigned int DS1307_clear_ticks(void)
+{
+    unsigned int ticks = 0;
+    
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ticks = DS1307_ticks;
+        DS1307_ticks = 0;
+    }
+    return ticks;
+}
+
+/*
+***************************************************************************************************
+* Function: DS1307_set_local
+* --------------------------
+*   Take a time read from or written to the RTC as the local time. DS1307_clear_ticks must
+*   have been called before the transaction.
+*
+***************************************************************************************************
+*/
+static void DS1307_set_local(const DS1307_time *time)
+{
+    DS1307_local = *time;
+    DS1307_since_sync = 0;
+    DS1307_synced = true;
+}
+
+/*
+***************************************************************************************************
+* Function: DS1307_write_time
+* ---------------------------
+*   Set the RTC (one burst write of the 7 time registers). Starts the oscillator and selects the
+*   24-hour mode.
+*
+*   time: new time
+*
+*   returns: result of the I2C transaction
+*
+***************************************************************************************************
+*/
+I2C_status DS1307_write_time(const DS1307_time *time)
+{
+    unsigned char raw[7];
+    I2C_status    status;
+    
+    
+    raw[0] = decimal_to_BCD(time->seconds);                 /* CH = 0 */
+    raw[1] = decimal_to_BCD(time->minutes);
+    raw[2] = decimal_to_BCD(time->hours);                   /* Bit 6 = 0 -> 24-hour mode */
+    raw[3] = time->day;
+    raw[4] = decimal_to_BCD(time->date);
+    raw[5] = decimal_to_BCD(time->month);
+    raw[6] = decimal_to_BCD(time->year);
+    
+    DS1307_clear_ticks();
+    status = I2C_write_burst(DS1307_ADDRESS, DS1307_SECONDS, raw, sizeof(raw));
+    if (status == I2C_OK) {
+        DS1307_set_local(time);
+    }
+    
+    return status;
+}
+
+/*
+***************************************************************************************************
+* Function: DS1307_sync
+* ---------------------
+*   Read the RTC and take it as the local time. If a second started during the read, it is not
+*   known whether the read has it already, so the RTC is read once more.
+*
+*   returns: result of the I2C transaction
+*
+***************************************************************************************************
+*/
+static I2C_status DS1307_sync(void)
+{
+    DS1307_time   time;
+    unsigned char attempt;
+    bool          second_started = false;
+    I2C_status    status;
+    
+    
+    for (attempt = 0; attempt < 2; ++attempt) {
+        DS1307_clear_ticks();
+        status = DS1307_read_time(&time);
+        if (status != I2C_OK) {
+            return status;
+        }
+    
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            second_started = (DS1307_ticks != 0);
+        }
+        if (!second_started) {
+            break;
+        }
+    }
+    
+    DS1307_set_local(&time);
+    
+    return I2C_OK;
+}
+
+/*
+***************************************************************************************************
+* Function: DS1307_init
+* ---------------------
+*   Enable the 1Hz output of the RTC and the pin change interrupt on SQW, read the time.
+*   I2C_init has to be called before.
+*
+*   returns: result of the I2C transactions
+*
+***************************************************************************************************
+*/
+I2C_status DS1307_init(void)
+{
+    I2C_status status;
+    
+    
+    DS1307_SQW_DDR &= ~(1 << DS1307_SQW);                   /* SQW as input with pull-up */
+    DS1307_SQW_PUE |= (1 << DS1307_SQW);
+    
+    status = I2C_write(DS1307_ADDRESS, DS1307_CONTROL, DS1307_SQW_1HZ);
+    if (status != I2C_OK) {
+        return status;
+    }
+    
+    status = DS1307_sync();
+    
+    DS1307_SQW_PCMSK |= (1 << DS1307_SQW);
+    GIMSK |= (1 << DS1307_SQW_PCIE);
+    sei();
+    
+    return status;
+}
+
+/*
+***************************************************************************************************
+* Function: DS1307_add_second
+* ---------------------------
+*   Advance the local time by one second (leap years 2000...2099).
+*
+***************************************************************************************************
+*/
+static void DS1307_add_second(void)
+{
+    DS1307_time  *t = &DS1307_local;
+    unsigned char days;
+    
+    
+    if (++t->seconds < 60) {
+        return;
+    }
+    t->seconds = 0;
+    
+    if (++t->minutes < 60) {
+        return;
+    }
+    t->minutes = 0;
+    
+    if (++t->hours < 24) {
+        return;
+    }
+    t->hours = 0;
+    
+    if (++t->day > 7) {
+        t->day = 1;
+    }
+    
+    days = pgm_read_byte(&DS1307_days_in_month[t->month - 1]);
+    if ((t->month == 2) && ((t->year & 0x03) == 0)) {
+        days = 29;
+    }
+    
+    if (++t->date <= days) {
+        return;
+    }
+    t->date = 1;
+    
+    if (++t->month <= 12) {
+        return;
+    }
+    t->month = 1;
+    
+    if (++t->year > 99) {
+        t->year = 0;
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: DS1307_get_time
+* -------------------------
+*   Get the current time without a bus transaction. The RTC is only read if
+*   DS1307_RESYNC_SECONDS have passed since the last read (or no read was successful yet), also
+*   if the second counter stopped at 0xFFFF (no call for more than 18 hours).
+*
+*   time: destination
+*
+*   returns: I2C_OK or the result of the resync (the local time is returned anyway)
+*
+***************************************************************************************************
+*/
+I2C_status DS1307_get_time(DS1307_time *time)
+{
+    unsigned int ticks;
+    I2C_status   status = I2C_OK;
+    
+    
+    ticks = DS1307_clear_ticks();
+    if (ticks == 0xFFFF) {
+        DS1307_synced = false;                              /* Seconds lost, the local time is wrong */
+        ticks = 0;                                          /* The resync sets it, do not count up 18h */
+    }
+    
+    while (ticks--) {
+        DS1307_add_second();
+        if (DS1307_since_sync != 0xFFFF) {
+            DS1307_since_sync++;
+        }
+    }
+    
+    if (!DS1307_synced || (DS1307_since_sync >= DS1307_RESYNC_SECONDS)) {
+        status = DS1307_sync();
+    }
+    
+    *time = DS1307_local;
+    
+    return status;
+}
+
+
+/*
+***************************************************************************************************
+* Interrupt vector for the pin change interrupt of SQW
+* ----------------------------------------------------
+*   Count the falling edges of the 1Hz signal, the RTC updates its seconds with them.
+*
+***************************************************************************************************
+*/
+ISR (DS1307_SQW_vect)
+{
+    if (((DS1307_SQW_PIN & (1 << DS1307_SQW)) == 0) && (DS1307_ticks != 0xFFFF)) {
+        DS1307_ticks++;
+    }
+}
@@ -0,0 +1,86 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: DS1307.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for DS1307.c
+*
+***************************************************************************************************
+*/
+
+#ifndef DS1307_H_
+#define DS1307_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define DS1307_ADDRESS          0xD0        /* 8-bit address of RTC (7-bit 0x68) */
+
+#define DS1307_RESYNC_SECONDS   3600        /* Read the time from the RTC again after this time (1...65535) */
+
+/* SQW/OUT of the DS1307 (open drain, the internal pull-up is used) on a pin change interrupt */
+#define DS1307_SQW              2           /* SQW Bit */
+#define DS1307_SQW_DDR          DDRB
+#define DS1307_SQW_PIN          PINB
+#define DS1307_SQW_PUE          PUEB
+#define DS1307_SQW_PCMSK        PCMSK1      /* PB2 -> PCINT10, bit 2 of PCMSK1 */
+#define DS1307_SQW_PCIE         PCIE1
+#define DS1307_SQW_vect         PCINT1_vect
+
+/* End of configuration options. Do not change followings without care.                          */
+/*************************************************************************************************/
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+/* Registers */
+#define DS1307_SECONDS          0x00        /* First of the 7 time registers */
+#define DS1307_CONTROL          0x07
+
+#define DS1307_CH               0x80        /* Clock halt, bit 7 of the seconds register */
+#define DS1307_SQW_1HZ          0x10        /* Control: SQWE = 1, RS1..0 = 00 */
+
+/* Time in decimal, 24-hour mode */
+typedef struct {
+    unsigned char seconds;                  /* 0...59                       */
+    unsigned char minutes;                  /* 0...59                       */
+    unsigned char hours;                    /* 0...23                       */
+    unsigned char day;                      /* Day of the week 1...7        */
+    unsigned char date;                     /* 1...31                       */
+    unsigned char month;                    /* 1...12                       */
+    unsigned char year;                     /* 0...99 -> 2000...2099        */
+} DS1307_time;
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include "I2C_Master_Bit_Bang_Driver.h"
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+I2C_status DS1307_init(void);
+I2C_status DS1307_read_time(DS1307_time *time);
+I2C_status DS1307_write_time(const DS1307_time *time);
+I2C_status DS1307_get_time(DS1307_time *time);
+
+
+#endif /* DS1307_H_ */
@@ -0,0 +1,26 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/hal/avr/interrupt.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Host replacement of <avr/interrupt.h>. An ISR becomes a plain function with the
+*              name of the vector, the test program calls it to simulate the interrupt.
+*
+***************************************************************************************************
+*/
+
+#ifndef HAL_AVR_INTERRUPT_H_
+#define HAL_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+#define ISR(vector, ...)    void vector(void); void vector(void)
+
+#define sei()               ((void)0)
+#define cli()               ((void)0)
+
+
+#endif /* HAL_AVR_INTERRUPT_H_ */
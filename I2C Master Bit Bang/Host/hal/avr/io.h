@@ -0,0 +1,186 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/hal/avr/io.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Host replacement of <avr/io.h> for the ATtiny841 (hardware abstraction layer).
+*              DDRx, PORTx and PUEx are plain variables, PINx is evaluated by hal.c from the
+*              outputs of the MCU and the simulated devices on the pins. All other registers
+*              (USART, pin change, Timer1, PRR) are plain variables without function, a test
+*              program can read what the driver wrote and preset status bits.
+*
+***************************************************************************************************
+*/
+
+#ifndef HAL_AVR_IO_H_
+#define HAL_AVR_IO_H_
+
+#include <stdint.h>
+
+
+/*
+***************************************************************************************************
+**                                            PORTS
+***************************************************************************************************
+*/
+#define HAL_PORT_A      0
+#define HAL_PORT_B      1
+#define HAL_PORTS       2
+
+extern volatile uint8_t hal_ddr[HAL_PORTS];
+extern volatile uint8_t hal_port[HAL_PORTS];
+extern volatile uint8_t hal_pue[HAL_PORTS];
+
+uint8_t hal_pin(uint8_t port);
+
+#define DDRA            hal_ddr[HAL_PORT_A]
+#define DDRB            hal_ddr[HAL_PORT_B]
+#define PORTA           hal_port[HAL_PORT_A]
+#define PORTB           hal_port[HAL_PORT_B]
+#define PUEA            hal_pue[HAL_PORT_A]
+#define PUEB            hal_pue[HAL_PORT_B]
+#define PINA            hal_pin(HAL_PORT_A)
+#define PINB            hal_pin(HAL_PORT_B)
+
+
+/*
+***************************************************************************************************
+**                                        OTHER REGISTERS
+***************************************************************************************************
+*/
+extern volatile uint8_t  hal_UCSR0A;
+extern volatile uint8_t  hal_UCSR0B;
+extern volatile uint8_t  hal_UCSR0C;
+extern volatile uint8_t  hal_UCSR0D;
+extern volatile uint8_t  hal_UBRR0H;
+extern volatile uint8_t  hal_UBRR0L;
+extern volatile uint8_t  hal_UDR0;
+extern volatile uint8_t  hal_UCSR1A;
+extern volatile uint8_t  hal_UCSR1B;
+extern volatile uint8_t  hal_UCSR1C;
+extern volatile uint8_t  hal_UCSR1D;
+extern volatile uint8_t  hal_UBRR1H;
+extern volatile uint8_t  hal_UBRR1L;
+extern volatile uint8_t  hal_UDR1;
+extern volatile uint8_t  hal_GIMSK;
+extern volatile uint8_t  hal_GIFR;
+extern volatile uint8_t  hal_PCMSK0;
+extern volatile uint8_t  hal_PCMSK1;
+extern volatile uint8_t  hal_MCUCR;
+extern volatile uint8_t  hal_PRR;
+extern volatile uint8_t  hal_TCCR1A;
+extern volatile uint8_t  hal_TCCR1B;
+extern volatile uint8_t  hal_TCCR1C;
+extern volatile uint8_t  hal_TIMSK1;
+extern volatile uint8_t  hal_TIFR1;
+extern volatile uint16_t hal_TCNT1;
+extern volatile uint16_t hal_OCR1A;
+extern volatile uint16_t hal_OCR1B;
+extern volatile uint16_t hal_ICR1;
+
+#define UCSR0A          hal_UCSR0A
+#define UCSR0B          hal_UCSR0B
+#define UCSR0C          hal_UCSR0C
+#define UCSR0D          hal_UCSR0D
+#define UBRR0H          hal_UBRR0H
+#define UBRR0L          hal_UBRR0L
+#define UDR0            hal_UDR0
+#define UCSR1A          hal_UCSR1A
+#define UCSR1B          hal_UCSR1B
+#define UCSR1C          hal_UCSR1C
+#define UCSR1D          hal_UCSR1D
+#define UBRR1H          hal_UBRR1H
+#define UBRR1L          hal_UBRR1L
+#define UDR1            hal_UDR1
+#define GIMSK           hal_GIMSK
+#define GIFR            hal_GIFR
+#define PCMSK0          hal_PCMSK0
+#define PCMSK1          hal_PCMSK1
+#define MCUCR           hal_MCUCR
+#define PRR             hal_PRR
+#define TCCR1A          hal_TCCR1A
+#define TCCR1B          hal_TCCR1B
+#define TCCR1C          hal_TCCR1C
+#define TIMSK1          hal_TIMSK1
+#define TIFR1           hal_TIFR1
+#define TCNT1           hal_TCNT1
+#define OCR1A           hal_OCR1A
+#define OCR1B           hal_OCR1B
+#define ICR1            hal_ICR1
+
+/* Bits */
+#define RXC0            7
+#define TXC0            6
+#define UDRE0           5
+#define FE0             4
+#define DOR0            3
+#define UPE0            2
+#define U2X0            1
+#define MPCM0           0
+#define RXCIE0          7
+#define TXCIE0          6
+#define UDRIE0          5
+#define RXEN0           4
+#define TXEN0           3
+#define UCSZ02          2
+#define RXB80           1
+#define TXB80           0
+#define UMSEL01         7
+#define UMSEL00         6
+#define UPM01           5
+#define UPM00           4
+#define USBS0           3
+#define UCSZ01          2
+#define UCSZ00          1
+#define UCPOL0          0
+#define RXC1            7
+#define TXC1            6
+#define UDRE1           5
+#define FE1             4
+#define DOR1            3
+#define UPE1            2
+#define U2X1            1
+#define MPCM1           0
+#define RXCIE1          7
+#define TXCIE1          6
+#define UDRIE1          5
+#define RXEN1           4
+#define TXEN1           3
+#define UCSZ12          2
+#define RXB81           1
+#define TXB81           0
+#define UMSEL11         7
+#define UMSEL10         6
+#define UPM11           5
+#define UPM10           4
+#define USBS1           3
+#define UCSZ11          2
+#define UCSZ10          1
+#define UCPOL1          0
+#define PCIE0           4
+#define PCIE1           5
+#define PRADC           0
+#define PRTIM0          1
+#define PRTIM1          2
+#define PRTIM2          3
+#define PRSPI           4
+#define PRUSART0        5
+#define PRUSART1        6
+#define PRTWI           7
+#define CS10            0
+#define CS11            1
+#define CS12            2
+#define WGM12           3
+#define WGM13           4
+#define TOIE1           0
+#define OCIE1A          1
+#define OCIE1B          2
+#define OCF1A           1
+
+#define _BV(bit)        (1 << (bit))
+
+
+#endif /* HAL_AVR_IO_H_ */
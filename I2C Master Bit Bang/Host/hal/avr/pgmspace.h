@@ -0,0 +1,25 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/hal/avr/pgmspace.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Host replacement of <avr/pgmspace.h>, flash data is ordinary const data.
+*
+***************************************************************************************************
+*/
+
+#ifndef HAL_AVR_PGMSPACE_H_
+#define HAL_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+
+#define PROGMEM
+#define PSTR(string)            (string)
+#define pgm_read_byte(address)  (*(const uint8_t *)(address))
+#define pgm_read_word(address)  (*(const uint16_t *)(address))
+
+
+#endif /* HAL_AVR_PGMSPACE_H_ */
@@ -0,0 +1,29 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/hal/avr/sleep.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Host replacement of <avr/sleep.h>. The CPU does not sleep, a sleep returns at
+*              once like after an interrupt.
+*
+***************************************************************************************************
+*/
+
+#ifndef HAL_AVR_SLEEP_H_
+#define HAL_AVR_SLEEP_H_
+
+#define SLEEP_MODE_IDLE         0
+#define SLEEP_MODE_PWR_DOWN     2
+#define SLEEP_MODE_STANDBY      3
+
+#define set_sleep_mode(mode)    ((void)(mode))
+#define sleep_enable()          ((void)0)
+#define sleep_disable()         ((void)0)
+#define sleep_cpu()             ((void)0)
+#define sleep_mode()            ((void)0)
+
+
+#endif /* HAL_AVR_SLEEP_H_ */
@@ -0,0 +1,150 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/hal/hal.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Register storage and pin evaluation of the host HAL.
+*              A pin is low if the MCU drives it low (DDR = 1, PORT = 0) or an external device
+*              pulls it low (hal_external_low), otherwise it is high (output high, pull-up of
+*              the MCU or the pull-up resistor of the bus).
+*              Before a pin is read and on every delay, hal_update lets the simulated devices
+*              react to the outputs of the MCU.
+*
+***************************************************************************************************
+*/
+
+#include "hal.h"
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+volatile uint8_t hal_ddr[HAL_PORTS];
+volatile uint8_t hal_port[HAL_PORTS];
+volatile uint8_t hal_pue[HAL_PORTS];
+
+volatile uint8_t  hal_UCSR0A;
+volatile uint8_t  hal_UCSR0B;
+volatile uint8_t  hal_UCSR0C;
+volatile uint8_t  hal_UCSR0D;
+volatile uint8_t  hal_UBRR0H;
+volatile uint8_t  hal_UBRR0L;
+volatile uint8_t  hal_UDR0;
+volatile uint8_t  hal_UCSR1A;
+volatile uint8_t  hal_UCSR1B;
+volatile uint8_t  hal_UCSR1C;
+volatile uint8_t  hal_UCSR1D;
+volatile uint8_t  hal_UBRR1H;
+volatile uint8_t  hal_UBRR1L;
+volatile uint8_t  hal_UDR1;
+volatile uint8_t  hal_GIMSK;
+volatile uint8_t  hal_GIFR;
+volatile uint8_t  hal_PCMSK0;
+volatile uint8_t  hal_PCMSK1;
+volatile uint8_t  hal_MCUCR;
+volatile uint8_t  hal_PRR;
+volatile uint8_t  hal_TCCR1A;
+volatile uint8_t  hal_TCCR1B;
+volatile uint8_t  hal_TCCR1C;
+volatile uint8_t  hal_TIMSK1;
+volatile uint8_t  hal_TIFR1;
+volatile uint16_t hal_TCNT1;
+volatile uint16_t hal_OCR1A;
+volatile uint16_t hal_OCR1B;
+volatile uint16_t hal_ICR1;
+
+unsigned long   hal_cycles = 0;
+uint8_t         hal_external_low[HAL_PORTS];
+void          (*hal_update)(void) = 0;
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: hal_output
+* --------------------
+*   Levels of a port as driven by the MCU alone (inputs are high).
+*
+***************************************************************************************************
+*/
+uint8_t hal_output(uint8_t port)
+{
+    return hal_port[port] | (uint8_t)~hal_ddr[port];
+}
+
+/*
+***************************************************************************************************
+* Function: hal_level
+* -------------------
+*   Level of one pin with the MCU and the external devices, without calling hal_update.
+*
+***************************************************************************************************
+*/
+bool hal_level(uint8_t port, uint8_t bit)
+{
+    return ((hal_output(port) & (uint8_t)~hal_external_low[port]) & (1 << bit)) != 0;
+}
+
+/*
+***************************************************************************************************
+* Function: hal_pin
+* -----------------
+*   PINx of the MCU.
+*
+***************************************************************************************************
+*/
+uint8_t hal_pin(uint8_t port)
+{
+    if (hal_update) {
+        hal_update();
+    }
+    return hal_output(port) & (uint8_t)~hal_external_low[port];
+}
+
+/*
+***************************************************************************************************
+* Function: hal_delay_cycles
+* --------------------------
+*   Busy wait of the MCU: the devices see the pins, then the time advances.
+*
+***************************************************************************************************
+*/
+void hal_delay_cycles(unsigned long cycles)
+{
+    if (hal_update) {
+        hal_update();
+    }
+    hal_cycles += cycles;
+}
+
+/*
+***************************************************************************************************
+* Function: hal_reset
+* -------------------
+*   All pins to input, no external pull-downs, time 0.
+*
+***************************************************************************************************
+*/
+void hal_reset(void)
+{
+    uint8_t port;
+    
+    
+    for (port = 0; port < HAL_PORTS; ++port) {
+        hal_ddr[port] = 0;
+        hal_port[port] = 0;
+        hal_pue[port] = 0;
+        hal_external_low[port] = 0;
+    }
+    hal_cycles = 0;
+}
@@ -0,0 +1,48 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/hal/hal.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for hal.c (simulation side of the host HAL).
+*
+***************************************************************************************************
+*/
+
+#ifndef HAL_H_
+#define HAL_H_
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include <avr/io.h>
+#include <stdbool.h>
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+extern unsigned long    hal_cycles;                     /* Simulated CPU cycles (delays only)    */
+extern uint8_t          hal_external_low[HAL_PORTS];    /* Pins pulled low by external devices   */
+extern void           (*hal_update)(void);              /* Called before the pins are sampled    */
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+uint8_t hal_output(uint8_t port);
+void hal_delay_cycles(unsigned long cycles);
+bool hal_level(uint8_t port, uint8_t bit);
+void hal_reset(void);
+
+
+#endif /* HAL_H_ */
@@ -0,0 +1,23 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/hal/util/atomic.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Host replacement of <util/atomic.h>. The host program is single threaded and
+*              calls "interrupts" itself, so the blocks run once without any locking.
+*
+***************************************************************************************************
+*/
+
+#ifndef HAL_UTIL_ATOMIC_H_
+#define HAL_UTIL_ATOMIC_H_
+
+#define ATOMIC_BLOCK(type)      for (int hal_atomic_once = 1; hal_atomic_once; hal_atomic_once = 0)
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_FORCEON
+
+
+#endif /* HAL_UTIL_ATOMIC_H_ */
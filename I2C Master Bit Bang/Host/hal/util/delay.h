@@ -0,0 +1,29 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/hal/util/delay.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Host replacement of <util/delay.h>. Delays do not wait, they advance the
+*              simulated CPU time (hal_cycles) and let the simulated devices see the pins.
+*
+***************************************************************************************************
+*/
+
+#ifndef HAL_UTIL_DELAY_H_
+#define HAL_UTIL_DELAY_H_
+
+#ifndef F_CPU
+#error "F_CPU must be defined before <util/delay.h>"
+#endif
+
+void hal_delay_cycles(unsigned long cycles);
+
+#define __builtin_avr_delay_cycles(cycles)  hal_delay_cycles(cycles)
+#define _delay_us(us)                       hal_delay_cycles((unsigned long)((us) * (F_CPU / 1000000.0)))
+#define _delay_ms(ms)                       hal_delay_cycles((unsigned long)((ms) * (F_CPU / 1000.0)))
+
+
+#endif /* HAL_UTIL_DELAY_H_ */
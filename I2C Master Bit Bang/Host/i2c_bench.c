@@ -0,0 +1,128 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/i2c_bench.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Benchmark of the I2C drivers on the host against the simulated DS1307 and
+*              AT24C32. For every operation it counts the SCL clocks (sim_i2c.time) and the
+*              delay cycles of the driver (hal_cycles). The code between the delays is not
+*              simulated, it is added as I2C_LOW_OVERHEAD_CYCLES + I2C_HIGH_OVERHEAD_CYCLES per
+*              SCL clock (counted per instruction, see I2C_Master_Bit_Bang_Driver.h), calls
+*              between the bytes are not included. The report is JSON on stdout.
+*
+*              make bench  ->  bench_results.json
+*
+***************************************************************************************************
+*/
+
+#include <stdio.h>
+
+#include "i2c_models.h"
+#include "I2C_Master_Bit_Bang_Driver.h"
+#include "AT24C32.h"
+#include "DS1307.h"
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define BENCH_BIT_OVERHEAD      (I2C_LOW_OVERHEAD_CYCLES + I2C_HIGH_OVERHEAD_CYCLES)
+
+/* Run operation (true -> successful) and report the clocks and delay cycles it took */
+#define BENCH(name, payload, operation)                                                         \
+    do {                                                                                        \
+        unsigned long bench_clocks = sim_i2c.time;                                              \
+        unsigned long bench_delay = hal_cycles;                                                 \
+        bool          bench_ok = (operation);                                                   \
+        report((name), bench_ok, (payload), sim_i2c.time - bench_clocks, hal_cycles - bench_delay); \
+    } while (0)
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static sim_ds1307   rtc;
+static sim_at24c32  eeprom;
+static int          failed = 0;
+static bool         first = true;                               /* No comma before the first result */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+static void setup(void)
+{
+    hal_reset();
+    sim_i2c_init(HAL_PORT_A, I2C_SCL, HAL_PORT_A, I2C_SDA);
+    sim_ds1307_init(&rtc, DS1307_ADDRESS);
+    sim_at24c32_init(&eeprom, AT24C32_ADDRESS);
+    sim_i2c_attach(&rtc.slave);
+    sim_i2c_attach(&eeprom.slave);
+    I2C_init();
+}
+
+/* Print the result of one operation. clocks and delay are the differences over the operation,
+ * payload the data bytes (without address and register bytes). */
+static void report(const char *name, bool ok, unsigned int payload, unsigned long clocks, unsigned long delay)
+{
+    unsigned long code = clocks * BENCH_BIT_OVERHEAD;
+    unsigned long cycles = delay + code;
+    
+    
+    if (!ok || (clocks == 0)) {
+        failed = 1;
+        fprintf(stderr, "%s failed\n", name);
+        return;
+    }
+    
+    printf("%s\n    {\"name\": \"%s\", \"payload_bytes\": %u, \"scl_clocks\": %lu, "
+           "\"delay_cycles\": %lu, \"code_cycles\": %lu, \"cycles_per_bit\": %.1f, "
+           "\"scl_hz\": %.0f, \"payload_bytes_per_s\": %.0f}",
+           first ? "" : ",", name, payload, clocks, delay, code, (double)cycles / clocks,
+           (double)F_CPU * clocks / cycles, (double)F_CPU * payload / cycles);
+    first = false;
+}
+
+
+/*
+***************************************************************************************************
+**                                              MAIN
+***************************************************************************************************
+*/
+int main(void)
+{
+    DS1307_time   time = { 56, 34, 12, 3, 29, 2, 24 };
+    unsigned char data[AT24C32_PAGE_SIZE];
+    unsigned char byte = 0;
+    unsigned int  i;
+    
+    
+    setup();
+    for (i = 0; i < sizeof(data); ++i) {
+        data[i] = (unsigned char)i;
+    }
+    
+    printf("{\n  \"f_cpu\": %lu, \"i2c_speed\": %lu, \"low_overhead_cycles\": %u, \"high_overhead_cycles\": %u,\n",
+           (unsigned long)F_CPU, (unsigned long)I2C_SPEED, I2C_LOW_OVERHEAD_CYCLES, I2C_HIGH_OVERHEAD_CYCLES);
+    printf("  \"results\": [");
+    
+    BENCH("I2C_write", 1, I2C_write(DS1307_ADDRESS, 0x08, 0x55) == I2C_OK);
+    BENCH("I2C_read", 1, I2C_read(DS1307_ADDRESS, 0x08, &byte) == I2C_OK && byte == 0x55);
+    BENCH("DS1307_write_time", 7, DS1307_write_time(&time) == I2C_OK);
+    BENCH("DS1307_read_time", 7, DS1307_read_time(&time) == I2C_OK);
+    BENCH("AT24C32_read 32 bytes", sizeof(data), AT24C32_read(0x0000, data, sizeof(data)) == I2C_OK);
+    BENCH("AT24C32_write 32 bytes (page)", sizeof(data), AT24C32_write(0x0020, data, sizeof(data)) == I2C_OK);
+    
+    printf("\n  ]\n}\n");
+    
+    return failed;
+}
@@ -0,0 +1,464 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/i2c_models.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Simulated open-drain I2C bus with slave models of the DS1307 and the AT24C32.
+*              The bus is evaluated every time the driver samples a pin or waits (hal_update):
+*              SCL/SDA edges are decoded into START, STOP and bits exactly like a slave would
+*              see them. Slaves drive SDA only after a falling edge of SCL.
+*              If SCL and SDA change in the same step, SDA is taken first on a rising edge of
+*              SCL (setup time) and last on a falling edge (hold time).
+*
+***************************************************************************************************
+*/
+
+#include "i2c_models.h"
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+/* States of a slave */
+#define SIM_IDLE        0           /* Not addressed, waits for START       */
+#define SIM_ADDRESS     1           /* Receiving the address byte           */
+#define SIM_RX          2           /* Master writes                        */
+#define SIM_TX          3           /* Master reads                         */
+#define SIM_TX_END      4           /* Master sent NACK, waits for STOP     */
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+sim_i2c_stats sim_i2c;
+
+static uint8_t          sim_scl_port, sim_scl_bit;
+static uint8_t          sim_sda_port, sim_sda_bit;
+static sim_slave       *sim_slaves[SIM_MAX_SLAVES];
+static unsigned char    sim_slave_count = 0;
+
+static bool             sim_scl = true;             /* Bus levels at the last update */
+static bool             sim_sda = true;
+static bool             sim_in_transaction = false;
+static unsigned long    sim_clocks;                 /* SCL pulses of the running transaction */
+
+static bool             sim_hold_scl = false;       /* Fault injection */
+static unsigned int     sim_hold_sda = 0;
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: sim_slaves_sda_low
+* ----------------------------
+*   returns: true if a slave or the fault injection pulls SDA low
+*
+***************************************************************************************************
+*/
+static bool sim_slaves_sda_low(void)
+{
+    unsigned char i;
+    
+    
+    if (sim_hold_sda > 0) {
+        return true;
+    }
+    for (i = 0; i < sim_slave_count; ++i) {
+        if (sim_slaves[i]->sda_low) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+***************************************************************************************************
+* Function: sim_start
+* -------------------
+*   START or repeated START: every slave listens for its address.
+*
+***************************************************************************************************
+*/
+static void sim_start(void)
+{
+    unsigned char i;
+    
+    
+    if (!sim_in_transaction) {
+        sim_in_transaction = true;
+        sim_clocks = 0;
+    }
+    
+    for (i = 0; i < sim_slave_count; ++i) {
+        sim_slaves[i]->state = SIM_ADDRESS;
+        sim_slaves[i]->bit = -1;
+        sim_slaves[i]->shift = 0;
+        sim_slaves[i]->sda_low = false;
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: sim_stop
+* ------------------
+*   STOP: end of the transaction.
+*
+***************************************************************************************************
+*/
+static void sim_stop(void)
+{
+    unsigned char i;
+    
+    
+    if (sim_in_transaction) {
+        sim_in_transaction = false;
+        sim_i2c.transactions++;
+        sim_i2c.clocks += sim_clocks;
+        sim_i2c.last_clocks = sim_clocks;
+    }
+    
+    for (i = 0; i < sim_slave_count; ++i) {
+        sim_slaves[i]->state = SIM_IDLE;
+        sim_slaves[i]->sda_low = false;
+        if (sim_slaves[i]->stop) {
+            sim_slaves[i]->stop(sim_slaves[i]);
+        }
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: sim_rising
+* --------------------
+*   Rising edge of SCL: slaves sample SDA.
+*
+***************************************************************************************************
+*/
+static void sim_rising(bool sda)
+{
+    unsigned char i;
+    sim_slave    *s;
+    
+    
+    sim_i2c.time++;
+    if (sim_in_transaction) {
+        sim_clocks++;
+    }
+    
+    for (i = 0; i < sim_slave_count; ++i) {
+        s = sim_slaves[i];
+    
+        if ((s->bit >= 0) && (s->bit < 8) && ((s->state == SIM_ADDRESS) || (s->state == SIM_RX))) {
+            s->shift = (s->shift << 1) | sda;
+        } else if ((s->bit == 8) && (s->state == SIM_TX) && sda) {
+            s->state = SIM_TX_END;                              /* Master sent NACK */
+        }
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: sim_falling
+* ---------------------
+*   Falling edge of SCL: slaves set SDA for the next bit.
+*
+***************************************************************************************************
+*/
+static void sim_falling(void)
+{
+    unsigned char i;
+    sim_slave    *s;
+    
+    
+    if (sim_hold_sda > 0) {
+        sim_hold_sda--;
+    }
+    
+    for (i = 0; i < sim_slave_count; ++i) {
+        s = sim_slaves[i];
+    
+        if (s->state == SIM_IDLE) {
+            continue;
+        }
+        if (s->bit < 0) {                                       /* SCL low after START */
+            s->bit = 0;
+            continue;
+        }
+    
+        s->bit++;
+    
+        if (s->bit < 8) {
+            s->sda_low = (s->state == SIM_TX) && !(s->shift & (0x80 >> s->bit));
+        } else if (s->bit == 8) {                               /* Acknowledge bit */
+            switch (s->state) {
+            case SIM_ADDRESS:
+                if (((s->shift & 0xFE) == s->address) && s->select(s, s->shift & 0x01)) {
+                    s->sda_low = true;
+                } else {
+                    s->state = SIM_IDLE;
+                    s->sda_low = false;
+                }
+                break;
+            case SIM_RX:
+                s->sda_low = s->write(s, s->shift, s->index++);
+                break;
+            default:
+                s->sda_low = false;                             /* Master acknowledges */
+                break;
+            }
+        } else {                                                /* Next byte */
+            s->bit = 0;
+            s->sda_low = false;
+    
+            if ((s->state == SIM_ADDRESS) && !(s->shift & 0x01)) {
+                s->state = SIM_RX;
+                s->index = 0;
+            } else if ((s->state == SIM_ADDRESS) || (s->state == SIM_TX)) {
+                s->state = SIM_TX;
+                s->shift = s->read(s);
+                s->sda_low = !(s->shift & 0x80);
+            } else if (s->state == SIM_TX_END) {
+                s->state = SIM_IDLE;
+            }
+        }
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: sim_i2c_update
+* ------------------------
+*   hal_update: decode the changes on the bus since the last call.
+*
+***************************************************************************************************
+*/
+static void sim_i2c_update(void)
+{
+    bool scl = ((hal_output(sim_scl_port) >> sim_scl_bit) & 0x01) && !sim_hold_scl;
+    bool sda = ((hal_output(sim_sda_port) >> sim_sda_bit) & 0x01) && !sim_slaves_sda_low();
+    
+    
+    if (scl != sim_scl) {
+        sim_scl = scl;
+        if (scl) {
+            sim_rising(sda);
+        } else {
+            sim_falling();
+        }
+    } else if (scl && (sda != sim_sda)) {
+        if (!sda) {
+            sim_start();
+        } else {
+            sim_stop();
+        }
+    }
+    
+    sim_sda = ((hal_output(sim_sda_port) >> sim_sda_bit) & 0x01) && !sim_slaves_sda_low();
+    
+    hal_external_low[sim_scl_port] &= ~(1 << sim_scl_bit);
+    hal_external_low[sim_sda_port] &= ~(1 << sim_sda_bit);
+    if (sim_hold_scl) {
+        hal_external_low[sim_scl_port] |= (1 << sim_scl_bit);
+    }
+    if (sim_slaves_sda_low()) {
+        hal_external_low[sim_sda_port] |= (1 << sim_sda_bit);
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: sim_i2c_init
+* ----------------------
+*   Put the simulated bus on two pins of the HAL, no slaves.
+*
+***************************************************************************************************
+*/
+void sim_i2c_init(uint8_t scl_port, uint8_t scl_bit, uint8_t sda_port, uint8_t sda_bit)
+{
+    sim_scl_port = scl_port;
+    sim_scl_bit = scl_bit;
+    sim_sda_port = sda_port;
+    sim_sda_bit = sda_bit;
+    sim_slave_count = 0;
+    sim_scl = true;
+    sim_sda = true;
+    sim_in_transaction = false;
+    sim_hold_scl = false;
+    sim_hold_sda = 0;
+    
+    hal_update = sim_i2c_update;
+}
+
+/*
+***************************************************************************************************
+* Function: sim_i2c_attach
+* ------------------------
+*   Connect a slave to the bus.
+*
+***************************************************************************************************
+*/
+void sim_i2c_attach(sim_slave *slave)
+{
+    if (sim_slave_count < SIM_MAX_SLAVES) {
+        slave->state = SIM_IDLE;
+        slave->sda_low = false;
+        sim_slaves[sim_slave_count++] = slave;
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: sim_i2c_hold_scl / sim_i2c_hold_sda
+* ---------------------------------------------
+*   Fault injection: a slave stretches SCL forever, or holds SDA low for the next SCL pulses
+*   (like a slave that was interrupted while sending a 0).
+*
+***************************************************************************************************
+*/
+void sim_i2c_hold_scl(bool hold)
+{
+    sim_hold_scl = hold;
+    sim_i2c_update();
+}
+
+void sim_i2c_hold_sda(unsigned int clocks)
+{
+    sim_hold_sda = clocks;
+    sim_i2c_update();
+}
+
+
+/*
+***************************************************************************************************
+**                                         DS1307 MODEL
+***************************************************************************************************
+*/
+static bool sim_ds1307_select(sim_slave *slave, bool read)
+{
+    (void)slave;
+    (void)read;
+    return true;
+}
+
+static bool sim_ds1307_write(sim_slave *slave, unsigned char byte, unsigned int index)
+{
+    sim_ds1307 *rtc = (sim_ds1307 *)slave;
+    
+    
+    if (index == 0) {
+        rtc->pointer = byte & 0x3F;                             /* Register pointer */
+    } else {
+        rtc->registers[rtc->pointer] = byte;
+        rtc->pointer = (rtc->pointer + 1) & 0x3F;
+    }
+    return true;
+}
+
+static unsigned char sim_ds1307_read(sim_slave *slave)
+{
+    sim_ds1307   *rtc = (sim_ds1307 *)slave;
+    unsigned char byte = rtc->registers[rtc->pointer];
+    
+    
+    rtc->pointer = (rtc->pointer + 1) & 0x3F;
+    return byte;
+}
+
+void sim_ds1307_init(sim_ds1307 *rtc, unsigned char address)
+{
+    unsigned char i;
+    
+    
+    for (i = 0; i < sizeof(rtc->registers); ++i) {
+        rtc->registers[i] = 0;
+    }
+    rtc->pointer = 0;
+    rtc->slave.address = address;
+    rtc->slave.select = sim_ds1307_select;
+    rtc->slave.write = sim_ds1307_write;
+    rtc->slave.read = sim_ds1307_read;
+    rtc->slave.stop = 0;
+}
+
+
+/*
+***************************************************************************************************
+**                                        AT24C32 MODEL
+***************************************************************************************************
+*/
+static bool sim_at24c32_select(sim_slave *slave, bool read)
+{
+    sim_at24c32 *eeprom = (sim_at24c32 *)slave;
+    
+    
+    (void)read;
+    return sim_i2c.time >= eeprom->busy_until;                    /* No ACK during the write cycle */
+}
+
+static bool sim_at24c32_write(sim_slave *slave, unsigned char byte, unsigned int index)
+{
+    sim_at24c32 *eeprom = (sim_at24c32 *)slave;
+    
+    
+    if (index == 0) {
+        eeprom->pointer = (unsigned int)(byte & 0x0F) << 8;
+    } else if (index == 1) {
+        eeprom->pointer |= byte;
+    } else {
+        eeprom->memory[eeprom->pointer] = byte;
+        eeprom->pointer = (eeprom->pointer & ~0x1Fu) | ((eeprom->pointer + 1) & 0x1F);   /* Wraps in the page */
+        eeprom->written = true;
+    }
+    return true;
+}
+
+static unsigned char sim_at24c32_read(sim_slave *slave)
+{
+    sim_at24c32  *eeprom = (sim_at24c32 *)slave;
+    unsigned char byte = eeprom->memory[eeprom->pointer];
+    
+    
+    eeprom->pointer = (eeprom->pointer + 1) & 0x0FFF;
+    return byte;
+}
+
+static void sim_at24c32_stop(sim_slave *slave)
+{
+    sim_at24c32 *eeprom = (sim_at24c32 *)slave;
+    
+    
+    if (eeprom->written) {
+        eeprom->written = false;
+        eeprom->busy_until = sim_i2c.time + SIM_AT24C32_WRITE_CLOCKS;
+    }
+}
+
+void sim_at24c32_init(sim_at24c32 *eeprom, unsigned char address)
+{
+    unsigned int i;
+    
+    
+    for (i = 0; i < sizeof(eeprom->memory); ++i) {
+        eeprom->memory[i] = 0xFF;
+    }
+    eeprom->pointer = 0;
+    eeprom->written = false;
+    eeprom->busy_until = 0;
+    eeprom->slave.address = address;
+    eeprom->slave.select = sim_at24c32_select;
+    eeprom->slave.write = sim_at24c32_write;
+    eeprom->slave.read = sim_at24c32_read;
+    eeprom->slave.stop = sim_at24c32_stop;
+}
@@ -0,0 +1,97 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/i2c_models.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for i2c_models.c
+*
+***************************************************************************************************
+*/
+
+#ifndef I2C_MODELS_H_
+#define I2C_MODELS_H_
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include "hal.h"
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define SIM_MAX_SLAVES          4
+#define SIM_AT24C32_WRITE_CLOCKS 1000UL     /* Write cycle of the EEPROM in SCL pulses, 10ms at 100kHz */
+
+/* One slave on the bus. The bit level is handled by i2c_models.c, the device only sees bytes. */
+typedef struct sim_slave {
+    unsigned char   address;                                        /* 8-bit address, R/W = 0 */
+    bool          (*select)(struct sim_slave *slave, bool read);     /* Address matched, true -> ACK */
+    bool          (*write)(struct sim_slave *slave, unsigned char byte, unsigned int index);  /* true -> ACK */
+    unsigned char (*read)(struct sim_slave *slave);
+    void          (*stop)(struct sim_slave *slave);
+    
+    /* Bit engine */
+    signed char     bit;                /* SCL falls in this byte, -1 -> first fall after START */
+    unsigned char   shift;
+    unsigned char   state;
+    unsigned int    index;              /* Bytes written since the address */
+    bool            sda_low;
+} sim_slave;
+
+/* Bus statistics, one transaction is START ... STOP (repeated STARTs included). The simulation
+ * has no CPU timing, the time base is the SCL pulse (one bit-time). */
+typedef struct {
+    unsigned long   transactions;
+    unsigned long   clocks;             /* SCL pulses of all transactions                       */
+    unsigned long   last_clocks;        /* SCL pulses of the last transaction                   */
+    unsigned long   time;               /* All SCL pulses, also outside of transactions         */
+} sim_i2c_stats;
+
+/* DS1307: 7 time registers, control, 56 bytes RAM */
+typedef struct {
+    sim_slave       slave;
+    unsigned char   registers[64];
+    unsigned char   pointer;
+} sim_ds1307;
+
+/* AT24C32: 4 KByte, 32 byte pages, 10ms write cycle */
+typedef struct {
+    sim_slave       slave;
+    unsigned char   memory[4096];
+    unsigned int    pointer;
+    bool            written;            /* Data bytes received, write cycle starts at STOP */
+    unsigned long   busy_until;         /* sim_i2c.time */
+} sim_at24c32;
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+extern sim_i2c_stats sim_i2c;
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+void sim_i2c_init(uint8_t scl_port, uint8_t scl_bit, uint8_t sda_port, uint8_t sda_bit);
+void sim_i2c_attach(sim_slave *slave);
+void sim_i2c_hold_scl(bool hold);
+void sim_i2c_hold_sda(unsigned int clocks);
+void sim_ds1307_init(sim_ds1307 *rtc, unsigned char address);
+void sim_at24c32_init(sim_at24c32 *eeprom, unsigned char address);
+
+
+#endif /* I2C_MODELS_H_ */
@@ -0,0 +1,143 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Host/i2c_sim.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Runs the I2C drivers on the host against the simulated DS1307 and AT24C32.
+*              Every check prints its result and the SCL pulses (bit-times) of the last
+*              transaction. Exit code 1 if a check failed.
+*
+*              make && ./i2c_sim
+*
+***************************************************************************************************
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "i2c_models.h"
+#include "I2C_Master_Bit_Bang_Driver.h"
+#include "AT24C32.h"
+#include "DS1307.h"
+#include "I2C_Cache.h"
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static sim_ds1307   rtc;
+static sim_at24c32  eeprom;
+static int          failed = 0;
+static unsigned long check_start = 0;                           /* sim_i2c.time at the end of the last check */
+
+void DS1307_SQW_vect(void);                                     /* ISR of DS1307.c */
+
+static const unsigned char rtc_volatile[2] = { 0x7F, 0x00 };
+I2C_CACHE_DEVICE(rtc_cache, DS1307_ADDRESS, 0x00, 16, rtc_volatile);
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+/* The condition is evaluated before the call, so the clocks since the last check are the SCL
+ * pulses of this check (0 if it did not use the bus) */
+static void check(const char *name, bool ok)
+{
+    printf("%-44s %-4s %5lu clocks\n", name, ok ? "ok" : "FAIL", sim_i2c.time - check_start);
+    check_start = sim_i2c.time;
+    if (!ok) {
+        failed = 1;
+    }
+}
+
+static void setup(void)
+{
+    hal_reset();
+    sim_i2c_init(HAL_PORT_A, I2C_SCL, HAL_PORT_A, I2C_SDA);
+    sim_ds1307_init(&rtc, DS1307_ADDRESS);
+    sim_at24c32_init(&eeprom, AT24C32_ADDRESS);
+    sim_i2c_attach(&rtc.slave);
+    sim_i2c_attach(&eeprom.slave);
+    I2C_init();
+    check_start = sim_i2c.time;
+}
+
+
+/*
+***************************************************************************************************
+**                                              MAIN
+***************************************************************************************************
+*/
+int main(void)
+{
+    DS1307_time   set = { 56, 34, 12, 3, 29, 2, 24 };
+    DS1307_time   get;
+    unsigned char data[40];
+    unsigned char byte = 0;
+    unsigned long transactions;
+    unsigned int  i;
+    
+    
+    setup();
+    
+    /* Single register */
+    check("I2C_write DS1307 RAM", I2C_write(DS1307_ADDRESS, 0x08, 0x55) == I2C_OK && rtc.registers[0x08] == 0x55);
+    check("I2C_read DS1307 RAM", I2C_read(DS1307_ADDRESS, 0x08, &byte) == I2C_OK && byte == 0x55);
+    check("I2C_write absent slave -> NACK", I2C_write(0x42, 0x00, 0x00) == I2C_ERROR_NACK);
+    
+    /* DS1307 */
+    check("DS1307_write_time", DS1307_write_time(&set) == I2C_OK && rtc.registers[0] == 0x56 && rtc.registers[6] == 0x24);
+    check("DS1307_read_time", DS1307_read_time(&get) == I2C_OK && memcmp(&get, &set, sizeof(get)) == 0);
+    check("DS1307_init (SQW 1Hz)", DS1307_init() == I2C_OK && rtc.registers[DS1307_CONTROL] == DS1307_SQW_1HZ);
+    
+    transactions = sim_i2c.transactions;
+    hal_external_low[HAL_PORT_B] |= (1 << DS1307_SQW);          /* SQW low -> falling edges */
+    for (i = 0; i < 5; ++i) {
+        DS1307_SQW_vect();
+    }
+    check("DS1307_get_time without bus access", DS1307_get_time(&get) == I2C_OK && get.seconds == 1 && get.minutes == 35 && sim_i2c.transactions == transactions);
+    
+    for (i = 0; i < 0xFFFF; ++i) {                              /* Counter stops, seconds are lost */
+        DS1307_SQW_vect();
+    }
+    DS1307_SQW_vect();
+    check("DS1307_get_time after 65535 s -> resync", DS1307_get_time(&get) == I2C_OK && get.seconds == 56 && get.minutes == 34 && sim_i2c.transactions > transactions);
+    
+    /* Register cache */
+    transactions = sim_i2c.transactions;
+    check("I2C_cache_write", I2C_cache_write(&rtc_cache, 0x09, 0xA5) == I2C_OK);
+    check("I2C_cache_read (hit, no bus)", I2C_cache_read(&rtc_cache, 0x09, &byte) == I2C_OK && byte == 0xA5 && rtc_cache.hits == 1 && sim_i2c.transactions == transactions + 1);
+    check("I2C_cache_read volatile (miss)", I2C_cache_read(&rtc_cache, 0x00, &byte) == I2C_OK && rtc_cache.misses == 1);
+    
+    /* AT24C32 across a page boundary */
+    for (i = 0; i < sizeof(data); ++i) {
+        data[i] = (unsigned char)(i * 7 + 1);
+    }
+    check("AT24C32_write 40 bytes at 0x001C", AT24C32_write(0x001C, data, sizeof(data)) == I2C_OK);
+    check("AT24C32 memory", memcmp(&eeprom.memory[0x001C], data, sizeof(data)) == 0);
+    memset(data, 0, sizeof(data));
+    check("AT24C32_read 40 bytes (after ACK polling)", AT24C32_read(0x001C, data, sizeof(data)) == I2C_OK && memcmp(&eeprom.memory[0x001C], data, sizeof(data)) == 0);
+    
+    /* Faults */
+    sim_i2c_hold_scl(true);
+    check("SCL held low -> timeout", I2C_write(DS1307_ADDRESS, 0x08, 0x00) == I2C_ERROR_TIMEOUT);
+    sim_i2c_hold_scl(false);
+    
+    sim_i2c_hold_sda(5);
+    check("SDA held low -> recovery", I2C_write(DS1307_ADDRESS, 0x08, 0x66) == I2C_OK && rtc.registers[0x08] == 0x66);
+    
+    sim_i2c_hold_sda(100);
+    check("SDA stuck low -> bus error", I2C_write(DS1307_ADDRESS, 0x08, 0x77) == I2C_ERROR_BUS);
+    sim_i2c_hold_sda(0);
+    
+    printf("%lu transactions, %lu clocks\n", sim_i2c.transactions, sim_i2c.clocks);
+    
+    return failed;
+}
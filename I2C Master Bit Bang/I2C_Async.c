@@ -0,0 +1,473 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: I2C_Async.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a non-blocking I2C master on the pins of the bit-bang driver (I2C_SCL,
+*              I2C_SDA). A Timer1 compare match ISR advances a bit-level state machine every
+*              half SCL period, so the CPU is free between the ticks.
+*              Transactions are described by an I2C_transaction and queued with
+*              I2C_async_submit. Completion is reported in the status of the descriptor and by
+*              an optional callback (called from the ISR).
+*
+*              Do not use the blocking I2C_... functions while transactions are queued, both
+*              drive the same pins. Single master only, there is no arbitration check.
+*              A slave that stretches the clock longer than I2C_TIMEOUT_US ends the transaction
+*              with I2C_ASYNC_TIMEOUT, both lines are released.
+*
+***************************************************************************************************
+*/
+
+#include "I2C_Async.h"
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+/* States of the bit-level state machine, one step per timer tick */
+#define ST_IDLE                 0
+#define ST_START_RELEASE_SDA    1       /* SCL low or idle: release SDA                     */
+#define ST_START_RELEASE_SCL    2       /* Release SCL                                      */
+#define ST_START                3       /* SCL high: SDA low -> START                       */
+#define ST_START_SCL_LOW        4       /* SCL low, first bit of the address byte           */
+#define ST_BIT_HIGH             5       /* Release SCL                                      */
+#define ST_BIT_SAMPLE           6       /* SCL high: sample SDA, SCL low, set next bit      */
+#define ST_STOP_SDA_LOW         7       /* SCL low: SDA low                                 */
+#define ST_STOP_RELEASE_SCL     8       /* Release SCL                                      */
+#define ST_STOP                 9       /* SCL high: release SDA -> STOP                    */
+#define ST_BUS_FREE             10      /* Bus free time before the next START              */
+
+/* Segments of a transaction */
+#define SEG_ADDRESS_WRITE       0
+#define SEG_WRITE               1
+#define SEG_ADDRESS_READ        2
+#define SEG_READ                3
+
+/* Open drain pin operations on the pins of the bit-bang driver */
+#define SCL_RELEASE()           (I2C_SCL_DDR &= ~(1 << I2C_SCL))
+#define SCL_LOW()               (I2C_SCL_DDR |= (1 << I2C_SCL))
+#define SCL_IS_LOW()            ((I2C_SCL_PIN & (1 << I2C_SCL)) == 0)
+#define SDA_RELEASE()           (I2C_SDA_DDR &= ~(1 << I2C_SDA))
+#define SDA_LOW()               (I2C_SDA_DDR |= (1 << I2C_SDA))
+#define SDA_IS_HIGH()           ((I2C_SDA_PIN & (1 << I2C_SDA)) != 0)
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static I2C_transaction *volatile I2C_async_queue[I2C_ASYNC_QUEUE_SIZE];
+static volatile unsigned char    I2C_async_head = 0;        /* Written by submit only */
+static volatile unsigned char    I2C_async_tail = 0;        /* Written by the ISR only */
+
+static I2C_transaction          *I2C_async_current;
+static volatile unsigned char    I2C_async_state = ST_IDLE;
+static unsigned char             I2C_async_segment;
+static unsigned char             I2C_async_index;           /* Byte in the segment */
+static unsigned char             I2C_async_bit;             /* 0...7 data, 8 acknowledge */
+static unsigned char             I2C_async_shift;           /* Byte being sent or received */
+static bool                      I2C_async_receiving;
+static bool                      I2C_async_restart;         /* START again after the STOP */
+static unsigned char             I2C_async_result;
+static unsigned char             I2C_async_stretch;         /* Ticks with SCL held low */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: I2C_async_init
+* ------------------------
+*   Initializes the pins and Timer1 (CTC mode, no prescaler). Timer1 is only powered (PRR) and
+*   its interrupt only enabled while transactions are running.
+*
+***************************************************************************************************
+*/
+void I2C_async_init(void)
+{
+    I2C_SCL_PORT &= ~(1 << I2C_SCL);                    /* Output level is always low */
+    I2C_SDA_PORT &= ~(1 << I2C_SDA);
+    SCL_RELEASE();
+    SDA_RELEASE();
+    
+    PRR &= ~(1<<PRTIM1);                                /* Registers are only accessible when powered */
+    TCCR1A = 0;
+    TCCR1B = (1<<WGM12)|(1<<CS10);                      /* CTC with OCR1A, F_CPU / 1 */
+    OCR1A  = I2C_ASYNC_TICKS - 1;
+    PRR |= (1<<PRTIM1);                                 /* Settings are kept while it is off */
+    
+    sei();
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_async_begin
+* -------------------------
+*   Take the next transaction from the queue and start it, or stop the timer if the queue is
+*   empty. Called with interrupts disabled.
+*
+***************************************************************************************************
+*/
+static void I2C_async_begin(void)
+{
+    unsigned char tail = I2C_async_tail;
+    
+    
+    if (tail == I2C_async_head) {
+        TIMSK1 &= ~(1<<OCIE1A);                         /* Nothing to do, no more ticks */
+        PRR |= (1<<PRTIM1);
+        I2C_async_state = ST_IDLE;
+        return;
+    }
+    
+    I2C_async_current = I2C_async_queue[tail];
+    I2C_async_tail = (tail + 1) & I2C_ASYNC_QUEUE_MASK;
+    
+    I2C_async_current->status = I2C_ASYNC_BUSY;
+    I2C_async_result = I2C_ASYNC_DONE;
+    I2C_async_restart = false;
+    I2C_async_stretch = 0;
+    
+    if ((I2C_async_current->write_length == 0) && (I2C_async_current->read_length > 0)) {
+        I2C_async_segment = SEG_ADDRESS_READ;
+    } else {
+        I2C_async_segment = SEG_ADDRESS_WRITE;
+    }
+    
+    I2C_async_state = ST_START_RELEASE_SDA;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_async_set_SDA
+* ---------------------------
+*   Put the current bit on SDA. Called while SCL is low.
+*
+***************************************************************************************************
+*/
+static void I2C_async_set_SDA(void)
+{
+    bool high;
+    
+    
+    if (I2C_async_bit < 8) {
+        high = I2C_async_receiving || (I2C_async_shift & 0x80);
+    } else if (I2C_async_receiving) {                   /* ACK all but the last byte */
+        high = (I2C_async_index + 1 >= I2C_async_current->read_length);
+    } else {
+        high = true;                                    /* Slave acknowledges */
+    }
+    
+    if (high) {
+        SDA_RELEASE();
+    } else {
+        SDA_LOW();
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_async_load
+* ------------------------
+*   Start the byte of the current segment and index. Called while SCL is low.
+*
+***************************************************************************************************
+*/
+static void I2C_async_load(void)
+{
+    I2C_transaction *t = I2C_async_current;
+    
+    
+    I2C_async_bit = 0;
+    I2C_async_receiving = false;
+    
+    switch (I2C_async_segment) {
+    case SEG_ADDRESS_WRITE:
+        I2C_async_shift = t->slave_address | I2C_WRITE;
+        break;
+    case SEG_WRITE:
+        I2C_async_shift = t->write_data[I2C_async_index];
+        break;
+    case SEG_ADDRESS_READ:
+        I2C_async_shift = t->slave_address | I2C_READ;
+        break;
+    default:
+        I2C_async_shift = 0;
+        I2C_async_receiving = true;
+        break;
+    }
+    
+    I2C_async_set_SDA();
+    I2C_async_state = ST_BIT_HIGH;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_async_byte_done
+* -----------------------------
+*   Decide what follows a complete byte (incl. acknowledge). Called while SCL is low.
+*
+*   nack: acknowledge bit sent by the slave (only for bytes sent by the master)
+*
+***************************************************************************************************
+*/
+static void I2C_async_byte_done(bool nack)
+{
+    I2C_transaction *t = I2C_async_current;
+    
+    
+    if (!I2C_async_receiving && nack) {
+        I2C_async_result = I2C_ASYNC_NACK;
+        I2C_async_state = ST_STOP_SDA_LOW;
+        return;
+    }
+    
+    switch (I2C_async_segment) {
+    case SEG_ADDRESS_WRITE:
+        I2C_async_index = 0;
+        if (t->write_length > 0) {
+            I2C_async_segment = SEG_WRITE;
+            I2C_async_load();
+            return;
+        }
+        break;
+    case SEG_WRITE:
+        if (++I2C_async_index < t->write_length) {
+            I2C_async_load();
+            return;
+        }
+        break;
+    case SEG_ADDRESS_READ:
+        I2C_async_index = 0;
+        I2C_async_segment = SEG_READ;
+        I2C_async_load();
+        return;
+    default:
+        t->read_data[I2C_async_index] = I2C_async_shift;
+        if (++I2C_async_index < t->read_length) {
+            I2C_async_load();
+            return;
+        }
+        I2C_async_state = ST_STOP_SDA_LOW;              /* Last byte read */
+        return;
+    }
+    
+    /* Write segment finished */
+    if (t->read_length > 0) {
+        I2C_async_segment = SEG_ADDRESS_READ;
+        if (t->repeated_start) {
+            I2C_async_state = ST_START_RELEASE_SDA;
+            return;
+        }
+        I2C_async_restart = true;
+    }
+    I2C_async_state = ST_STOP_SDA_LOW;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_async_finish
+* --------------------------
+*   Report the result of the current transaction, the next one starts after the bus free time.
+*
+***************************************************************************************************
+*/
+static void I2C_async_finish(void)
+{
+    I2C_async_current->status = I2C_async_result;
+    if (I2C_async_current->callback) {
+        I2C_async_current->callback(I2C_async_current);
+    }
+    I2C_async_state = ST_BUS_FREE;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_async_stretched
+* -----------------------------
+*   Check for clock stretching in a state that waits for SCL high. After
+*   I2C_ASYNC_STRETCH_TICKS ticks both lines are released and the transaction ends with
+*   I2C_ASYNC_TIMEOUT.
+*
+*   returns: true (SCL still low, the step is repeated or the transaction is ended) or false
+*
+***************************************************************************************************
+*/
+static bool I2C_async_stretched(void)
+{
+    if ( !SCL_IS_LOW() ) {
+        I2C_async_stretch = 0;
+        return false;
+    }
+    
+    if (++I2C_async_stretch >= I2C_ASYNC_STRETCH_TICKS) {
+        SCL_RELEASE();
+        SDA_RELEASE();
+        I2C_async_restart = false;
+        I2C_async_result = I2C_ASYNC_TIMEOUT;
+        I2C_async_finish();
+    }
+    return true;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_async_submit
+* --------------------------
+*   Queue a transaction. It starts right away if the bus is idle. May be called by a callback.
+*
+*   transaction: descriptor, must stay valid until it is finished
+*
+*   returns: true (queued) or false (queue full)
+*
+***************************************************************************************************
+*/
+bool I2C_async_submit(I2C_transaction *transaction)
+{
+    unsigned char head;
+    unsigned char next;
+    bool          queued = false;
+    
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {                 /* Also called by callbacks (ISR) */
+        head = I2C_async_head;
+        next = (head + 1) & I2C_ASYNC_QUEUE_MASK;
+        if (next != I2C_async_tail) {
+            transaction->status = I2C_ASYNC_QUEUED;
+            I2C_async_queue[head] = transaction;
+            I2C_async_head = next;
+            queued = true;
+            
+            if (I2C_async_state == ST_IDLE) {
+                I2C_async_begin();
+                PRR &= ~(1<<PRTIM1);
+                TCNT1 = 0;
+                TIFR1 = (1<<OCF1A);                     /* Clear old compare match */
+                TIMSK1 |= (1<<OCIE1A);
+            }
+        }
+    }
+    return queued;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_async_idle
+* ------------------------
+*   returns: true if no transaction is running or queued
+*
+***************************************************************************************************
+*/
+bool I2C_async_idle(void)
+{
+    return I2C_async_state == ST_IDLE;
+}
+
+
+/*
+***************************************************************************************************
+* Interrupt vector for Timer1 Compare Match A
+* -------------------------------------------
+*   One step of the state machine every half SCL period. If a slave stretches the clock, the
+*   step is repeated on the next tick, up to I2C_ASYNC_STRETCH_TICKS times.
+*
+***************************************************************************************************
+*/
+ISR (TIMER1_COMPA_vect)
+{
+    bool sda;
+    
+    
+    switch (I2C_async_state) {
+    case ST_START_RELEASE_SDA:
+        SDA_RELEASE();
+        I2C_async_state = ST_START_RELEASE_SCL;
+        break;
+        
+    case ST_START_RELEASE_SCL:
+        SCL_RELEASE();
+        I2C_async_state = ST_START;
+        break;
+        
+    case ST_START:
+        if (I2C_async_stretched()) {
+            break;                                      /* Clock stretching */
+        }
+        SDA_LOW();                                      /* SCL is high, SDA from 1 to 0 -> START */
+        I2C_async_state = ST_START_SCL_LOW;
+        break;
+        
+    case ST_START_SCL_LOW:
+        SCL_LOW();
+        I2C_async_load();
+        break;
+        
+    case ST_BIT_HIGH:
+        SCL_RELEASE();
+        I2C_async_state = ST_BIT_SAMPLE;
+        break;
+        
+    case ST_BIT_SAMPLE:
+        if (I2C_async_stretched()) {
+            break;                                      /* Clock stretching */
+        }
+        sda = SDA_IS_HIGH();
+        SCL_LOW();
+        
+        if (I2C_async_bit < 8) {
+            I2C_async_shift <<= 1;                      /* Sent bit out or received bit in */
+            if (I2C_async_receiving && sda) {
+                I2C_async_shift |= 0x01;
+            }
+            I2C_async_bit++;
+            I2C_async_set_SDA();
+            I2C_async_state = ST_BIT_HIGH;
+        } else {
+            I2C_async_byte_done(sda);
+        }
+        break;
+        
+    case ST_STOP_SDA_LOW:
+        SDA_LOW();
+        I2C_async_state = ST_STOP_RELEASE_SCL;
+        break;
+        
+    case ST_STOP_RELEASE_SCL:
+        SCL_RELEASE();
+        I2C_async_state = ST_STOP;
+        break;
+        
+    case ST_STOP:
+        if (I2C_async_stretched()) {
+            break;                                      /* Clock stretching */
+        }
+        SDA_RELEASE();                                  /* SCL is high, SDA from 0 to 1 -> STOP */
+        
+        if (I2C_async_restart) {
+            I2C_async_restart = false;
+            I2C_async_state = ST_START_RELEASE_SDA;    /* Read segment after STOP and START */
+            break;
+        }
+        
+        I2C_async_finish();
+        break;
+        
+    case ST_BUS_FREE:
+        I2C_async_begin();
+        break;
+        
+    default:
+        TIMSK1 &= ~(1<<OCIE1A);
+        break;
+    }
+}
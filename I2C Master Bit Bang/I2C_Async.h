@@ -0,0 +1,105 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: I2C_Async.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for I2C_Async.c
+*
+***************************************************************************************************
+*/
+
+#ifndef I2C_ASYNC_H_
+#define I2C_ASYNC_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define I2C_ASYNC_SPEED         2000UL      /* SCL frequency in Hz. The Timer1 ISR runs at twice */
+                                            /* this rate, about 40% CPU load at 1 MHz F_CPU      */
+
+#define I2C_ASYNC_QUEUE_SIZE    4           /* Queued transactions, must be a power of two */
+
+/* End of configuration options. Do not change followings without care.                          */
+/*************************************************************************************************/
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define I2C_ASYNC_TICKS         (F_CPU / (2UL * I2C_ASYNC_SPEED))   /* Timer1 cycles per half bit */
+#define I2C_ASYNC_QUEUE_MASK    (I2C_ASYNC_QUEUE_SIZE - 1)
+
+/* Ticks (half SCL periods) a slave may stretch the clock, bounded by I2C_TIMEOUT_US */
+#define I2C_ASYNC_STRETCH_TICKS ((I2C_TIMEOUT_US * 2UL * I2C_ASYNC_SPEED) / 1000000UL + 1)
+
+#if (I2C_ASYNC_QUEUE_SIZE & I2C_ASYNC_QUEUE_MASK) || (I2C_ASYNC_QUEUE_SIZE > 128)
+#error "I2C_ASYNC_QUEUE_SIZE must be a power of two up to 128"
+#endif
+
+/* Transaction status */
+#define I2C_ASYNC_IDLE          0           /* Not submitted yet              */
+#define I2C_ASYNC_QUEUED        1           /* Waiting in the queue           */
+#define I2C_ASYNC_BUSY          2           /* On the bus                     */
+#define I2C_ASYNC_DONE          3           /* Finished successfully          */
+#define I2C_ASYNC_NACK          4           /* Slave sent not acknowledge     */
+#define I2C_ASYNC_TIMEOUT       5           /* SCL held low, lines released   */
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include "I2C_Master_Bit_Bang_Driver.h"
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+/* F_CPU comes with the bit-bang driver header */
+#if (I2C_ASYNC_TICKS < 100) || (I2C_ASYNC_TICKS > 65536UL)
+#error "I2C_ASYNC_SPEED is out of range for F_CPU (ISR needs about 100 cycles)"
+#endif
+
+#if I2C_ASYNC_STRETCH_TICKS > 255
+#error "I2C_TIMEOUT_US is too long for I2C_ASYNC_SPEED"
+#endif
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+/* Transaction descriptor: START, address+W, write_data, (Sr or STOP+START), address+R,
+ * read_data, STOP. Either segment may be empty. The descriptor and the buffers must stay valid
+ * until status is I2C_ASYNC_DONE, I2C_ASYNC_NACK or I2C_ASYNC_TIMEOUT. */
+typedef struct I2C_transaction {
+    unsigned char           slave_address;      /* 8-bit slave address                          */
+    const unsigned char    *write_data;         /* Write segment (e.g. register address)        */
+    unsigned char           write_length;
+    unsigned char          *read_data;          /* Read segment                                 */
+    unsigned char           read_length;
+    bool                    repeated_start;     /* true -> Sr between the segments, else STOP   */
+    void                  (*callback)(struct I2C_transaction *transaction);  /* From ISR or NULL */
+    volatile unsigned char  status;
+} I2C_transaction;
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+void I2C_async_init(void);
+bool I2C_async_submit(I2C_transaction *transaction);
+bool I2C_async_idle(void);
+
+
+#endif /* I2C_ASYNC_H_ */
@@ -0,0 +1,156 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: I2C_Cache.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a write-through register shadow cache for slaves on bus 1 (I2C_...).
+*              Writes go to the bus and, if successful, into the cache. Reads of cached
+*              registers are served from SRAM, only the first read goes to the bus.
+*              Registers outside the cached range or marked volatile are always read from the
+*              bus. hits and misses of the device show how many bus reads were saved.
+*
+*              The cache only knows what went through these functions. Call I2C_cache_invalidate
+*              after a reset of the slave or after writing it with other functions.
+*
+***************************************************************************************************
+*/
+
+#include "I2C_Cache.h"
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: I2C_cache_index
+* -------------------------
+*   Index of a register in the cache.
+*
+*   returns: index (0...count-1) or -1 if the register is not cached (out of range or volatile)
+*
+***************************************************************************************************
+*/
+static int I2C_cache_index(const I2C_cache_device *device, unsigned char slave_register)
+{
+    unsigned char index = slave_register - device->first_register;
+    
+    
+    if ((slave_register < device->first_register) || (index >= device->count)) {
+        return -1;
+    }
+    
+    if (device->volatile_mask[index >> 3] & (1 << (index & 0x07))) {
+        return -1;
+    }
+    
+    return index;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_cache_read
+* ------------------------
+*   Read a register, from the cache if possible.
+*
+*   device:         cached device
+*   slave_register: slave register
+*   data:           destination
+*
+*   returns:        I2C_OK or the result of I2C_read
+*
+***************************************************************************************************
+*/
+I2C_status I2C_cache_read(I2C_cache_device *device, unsigned char slave_register, unsigned char *data)
+{
+    int           index = I2C_cache_index(device, slave_register);
+    unsigned char mask;
+    I2C_status    status;
+    
+    
+    if (index < 0) {
+        device->misses++;
+        return I2C_read(device->slave_address, slave_register, data);
+    }
+    
+    mask = 1 << (index & 0x07);
+    
+    if (device->valid[index >> 3] & mask) {
+        device->hits++;
+        *data = device->values[index];
+        return I2C_OK;
+    }
+    
+    device->misses++;
+    status = I2C_read(device->slave_address, slave_register, data);
+    if (status == I2C_OK) {
+        device->values[index] = *data;
+        device->valid[index >> 3] |= mask;
+    }
+    
+    return status;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_cache_write
+* -------------------------
+*   Write a register on the bus and update the cache (write-through). If the write fails, the
+*   register is read from the bus next time.
+*
+*   device:         cached device
+*   slave_register: slave register
+*   data_to_write:  byte to write
+*
+*   returns:        result of I2C_write
+*
+***************************************************************************************************
+*/
+I2C_status I2C_cache_write(I2C_cache_device *device, unsigned char slave_register, unsigned char data_to_write)
+{
+    int           index = I2C_cache_index(device, slave_register);
+    unsigned char mask;
+    I2C_status    status;
+    
+    
+    status = I2C_write(device->slave_address, slave_register, data_to_write);
+    
+    if (index >= 0) {
+        mask = 1 << (index & 0x07);
+    
+        if (status == I2C_OK) {
+            device->values[index] = data_to_write;
+            device->valid[index >> 3] |= mask;
+        } else {
+            device->valid[index >> 3] &= ~mask;
+        }
+    }
+    
+    return status;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_cache_invalidate
+* ------------------------------
+*   Forget all cached values of a device. The counters are not changed.
+*
+*   device: cached device
+*
+***************************************************************************************************
+*/
+void I2C_cache_invalidate(I2C_cache_device *device)
+{
+    unsigned char i;
+    
+    
+    for (i = 0; i < ((device->count + 7) >> 3); ++i) {
+        device->valid[i] = 0;
+    }
+}
@@ -0,0 +1,71 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: I2C_Cache.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for I2C_Cache.c
+*
+***************************************************************************************************
+*/
+
+#ifndef I2C_CACHE_H_
+#define I2C_CACHE_H_
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+/* Declare a cached device. The cache covers the registers first ... first + count - 1 and takes
+ * count + (count + 7) / 8 bytes of SRAM.
+ *
+ *   name:          name of the I2C_cache_device
+ *   address:       8-bit slave address
+ *   first:         first cached register
+ *   count:         number of cached registers (1...255)
+ *   volatile_mask: const unsigned char[(count + 7) / 8], bit n of byte n / 8 set -> register
+ *                  first + n changes by itself (e.g. time, status) and is always read from the bus
+ *
+ * Example: I2C_CACHE_DEVICE(rtc_cache, 0xD0, 0x00, 16, rtc_volatile);
+ */
+#define I2C_CACHE_DEVICE(name, address, first, count, volatile_mask)                              \
+static unsigned char name##_values[(count)];                                                      \
+static unsigned char name##_valid[((count) + 7) / 8];                                             \
+I2C_cache_device name = { (address), (first), (count), (volatile_mask), name##_values, name##_valid, 0, 0 }
+
+/* Shadow cache of one slave device */
+typedef struct {
+    unsigned char        slave_address;
+    unsigned char        first_register;
+    unsigned char        count;
+    const unsigned char *volatile_mask;     /* 1 bit per register, 1 -> never cached        */
+    unsigned char       *values;            /* Last value written or read, 1 byte/register  */
+    unsigned char       *valid;             /* 1 bit per register, 1 -> values is valid     */
+    unsigned int         hits;              /* Reads served from SRAM                       */
+    unsigned int         misses;            /* Reads that went to the bus                   */
+} I2C_cache_device;
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include "I2C_Master_Bit_Bang_Driver.h"
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+I2C_status I2C_cache_read(I2C_cache_device *device, unsigned char slave_register, unsigned char *data);
+I2C_status I2C_cache_write(I2C_cache_device *device, unsigned char slave_register, unsigned char data_to_write);
+void I2C_cache_invalidate(I2C_cache_device *device);
+
+
+#endif /* I2C_CACHE_H_ */
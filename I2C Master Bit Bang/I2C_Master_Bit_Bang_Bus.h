@@ -0,0 +1,754 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: I2C_Master_Bit_Bang_Bus.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Driver code for one bit-bang I2C bus. This file is included by
+*              I2C_Master_Bit_Bang_Driver.c once per bus with I2C_BUS set to the prefix of the
+*              bus (I2C or I2C2). Function names, pins and speed are pasted together at compile
+*              time (e.g. I2C_FN(_start) -> I2C2_start, I2C_FN(_SCL_DDR) -> I2C2_SCL_DDR), so
+*              every pin operation is a single sbi/cbi/sbic/sbis instruction and every bus has
+*              its own state.
+*
+*              No include guard, this file is meant to be included more than once.
+*
+***************************************************************************************************
+*/
+
+#ifndef I2C_BUS
+#error "Define I2C_BUS before including I2C_Master_Bit_Bang_Bus.h"
+#endif
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define I2C_PASTE(bus, name)    bus##name
+#define I2C_XPASTE(bus, name)   I2C_PASTE(bus, name)
+
+#define I2C_FN(name)            I2C_XPASTE(I2C_BUS, name)       /* I2C_FN(_start) -> I2C_start */
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static bool       I2C_FN(_started) = false;
+static I2C_status I2C_FN(_result) = I2C_OK;            /* Result of the running bus operation */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Pin operations
+* --------------
+*   The pins are open drain: the PORT bit stays 0, the line is pulled low by switching the pin to
+*   output and released (pulled high by the pull-up resistor) by switching it to input.
+*
+***************************************************************************************************
+*/
+static inline bool I2C_FN(_read_SCL)(void)
+{
+    return (I2C_FN(_SCL_PIN) & (1 << I2C_FN(_SCL))) != 0;
+}
+
+static inline bool I2C_FN(_read_SDA)(void)
+{
+    return (I2C_FN(_SDA_PIN) & (1 << I2C_FN(_SDA))) != 0;
+}
+
+static inline void I2C_FN(_set_SCL)(void)
+{
+    I2C_FN(_SCL_DDR) &= ~(1 << I2C_FN(_SCL));          /* SCL as input, pull-up will pull SCL high */
+}
+
+static inline void I2C_FN(_clear_SCL)(void)
+{
+    I2C_FN(_SCL_DDR) |= (1 << I2C_FN(_SCL));           /* SCL as output, PORT bit is 0 -> low */
+}
+
+static inline void I2C_FN(_set_SDA)(void)
+{
+    I2C_FN(_SDA_DDR) &= ~(1 << I2C_FN(_SDA));          /* SDA as input, pull-up will pull SDA high */
+}
+
+static inline void I2C_FN(_clear_SDA)(void)
+{
+    I2C_FN(_SDA_DDR) |= (1 << I2C_FN(_SDA));           /* SDA as output, PORT bit is 0 -> low */
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_init
+* ------------------
+*   Release both lines of the bus.
+*
+***************************************************************************************************
+*/
+void I2C_FN(_init)(void)
+{
+    I2C_FN(_SCL_PORT) &= ~(1 << I2C_FN(_SCL));         /* Output level is always low */
+    I2C_FN(_SDA_PORT) &= ~(1 << I2C_FN(_SDA));
+    I2C_FN(_set_SCL)();
+    I2C_FN(_set_SDA)();
+    
+    _delay_us(10);
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_wait_SCL
+* ----------------------
+*   Wait until SCL is high (clock stretching), at most I2C_TIMEOUT_US.
+*
+*   returns: true (SCL high) or false (timeout, the result is I2C_ERROR_TIMEOUT)
+*
+***************************************************************************************************
+*/
+static bool I2C_FN(_wait_SCL)(void)
+{
+    unsigned int loops = I2C_STRETCH_LOOPS(I2C_FN(_TIMEOUT_US));
+    
+    
+    while (I2C_FN(_read_SCL)() == 0) {
+        if (--loops == 0) {
+            I2C_FN(_result) = I2C_ERROR_TIMEOUT;
+            I2C_TRACE0(TRACE_I2C_TIMEOUT);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_abort
+* -------------------
+*   Release both lines after a timeout or lost arbitration. The next transaction starts with a
+*   new start condition.
+*
+*   returns: I2C_status of the failed operation
+*
+***************************************************************************************************
+*/
+static I2C_status I2C_FN(_abort)(void)
+{
+    I2C_FN(_set_SCL)();
+    I2C_FN(_set_SDA)();
+    I2C_FN(_started) = false;
+    
+    return I2C_FN(_result);
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_recover
+* ---------------------
+*   Bus recovery (UM10204, 3.1.16): a slave that holds SDA low, e.g. after a reset of the master
+*   in the middle of a read, gets up to 9 clocks to finish its byte. Then a stop condition puts
+*   all slaves back into idle.
+*
+*   returns: I2C_OK, I2C_ERROR_TIMEOUT or I2C_ERROR_BUS (SDA still low)
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_recover)(void)
+{
+    unsigned char clocks;
+    
+    
+    I2C_FN(_result) = I2C_OK;
+    I2C_FN(_set_SDA)();
+    
+    for (clocks = 0; (clocks < 9) && (I2C_FN(_read_SDA)() == 0); ++clocks) {
+        I2C_FN(_clear_SCL)();
+        I2C_DELAY_LOW(I2C_FN(_SPEED));
+        I2C_FN(_set_SCL)();
+        if ( !I2C_FN(_wait_SCL)() ) {
+            return I2C_FN(_abort)();
+        }
+        I2C_DELAY_HIGH(I2C_FN(_SPEED));
+    }
+    
+    I2C_FN(_clear_SCL)();
+    return I2C_FN(_stop)();
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_start
+* -------------------
+*   Do a I2C start condition. If a slave holds SDA low, the bus is recovered first.
+*
+*   returns: I2C_OK, I2C_ERROR_TIMEOUT or I2C_ERROR_BUS
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_start)(void)
+{
+    I2C_FN(_result) = I2C_OK;
+    
+    if (I2C_FN(_started)) {                  /* If I2C has started, do a restart condition */
+        I2C_FN(_set_SDA)();
+        I2C_DELAY_LOW(I2C_FN(_SPEED));
+        I2C_FN(_set_SCL)();
+        if ( !I2C_FN(_wait_SCL)() ) {           /* Clock stretching */
+            return I2C_FN(_abort)();
+        }
+        
+        I2C_DELAY_SU_STA(I2C_FN(_SPEED));
+    } else if ( !I2C_FN(_wait_SCL)() ) {       /* SCL held low on an idle bus */
+        return I2C_FN(_abort)();
+    }
+    
+    if (I2C_FN(_read_SDA)() == 0) {
+        I2C_FN(_started) = false;
+        if (I2C_FN(_recover)() != I2C_OK) {
+            return I2C_FN(_result);
+        }
+    }
+    
+    I2C_FN(_clear_SDA)();                        /* SCL is high, set SDA from 1 to 0 to start */
+    I2C_DELAY_HD_STA(I2C_FN(_SPEED));
+    I2C_FN(_clear_SCL)();
+    I2C_FN(_started) = true;
+    
+    return I2C_OK;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_stop
+* ------------------
+*   Do a I2C stop condition.
+*
+*   returns: I2C_OK, I2C_ERROR_TIMEOUT or I2C_ERROR_BUS (SDA still low after the stop)
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_stop)(void)
+{
+    I2C_FN(_result) = I2C_OK;
+    
+    I2C_FN(_clear_SDA)();
+    I2C_DELAY_LOW(I2C_FN(_SPEED));
+    I2C_FN(_set_SCL)();
+    if ( !I2C_FN(_wait_SCL)() ) {               /* Clock stretching */
+        return I2C_FN(_abort)();
+    }
+    I2C_DELAY_SU_STO(I2C_FN(_SPEED));
+    I2C_FN(_set_SDA)();                          /* SCL is high, set SDA from 0 to 1 to stop */
+    I2C_DELAY_BUF(I2C_FN(_SPEED));
+    I2C_FN(_started) = false;
+    
+    if (I2C_FN(_read_SDA)() == 0) {
+        I2C_FN(_result) = I2C_ERROR_BUS;
+        I2C_TRACE0(TRACE_I2C_BUS);
+    }
+    
+    return I2C_FN(_result);
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_write_bit
+* -----------------------
+*   Write a bit to the I2C Bus. A timeout or lost arbitration is recorded for
+*   I2C_write_byte/I2C_read_byte, SCL is then left released.
+*
+*   bit: bit to write
+*
+***************************************************************************************************
+*/
+void I2C_FN(_write_bit)(bool bit)
+{
+    if (bit) {
+        I2C_FN(_set_SDA)();
+        } else {
+        I2C_FN(_clear_SDA)();
+    }
+    
+    I2C_DELAY_LOW(I2C_FN(_SPEED));
+    I2C_FN(_set_SCL)();
+    
+    if ( !I2C_FN(_wait_SCL)() ) {               /* Clock stretching */
+        return;
+    }
+    
+    I2C_DELAY_HIGH(I2C_FN(_SPEED));             /* tHIGH counts from the release by the slave */
+    
+    if (bit && (I2C_FN(_read_SDA)() == 0)) {
+        I2C_FN(_result) = I2C_ERROR_ARBITRATION;
+        I2C_TRACE0(TRACE_I2C_ARBITRATION);
+        return;
+    }
+    
+    I2C_FN(_clear_SCL)();
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_read_bit
+* -----------------------
+*   Read a bit from the I2C Bus. A timeout is recorded for I2C_write_byte/I2C_read_byte.
+*
+*   returns: true (logic high) or false (logic low)
+*
+***************************************************************************************************
+*/
+bool I2C_FN(_read_bit)(void)
+{
+    bool bit;
+    
+    
+    I2C_FN(_set_SDA)();
+    I2C_DELAY_LOW(I2C_FN(_SPEED));
+    I2C_FN(_set_SCL)();
+    
+    if ( !I2C_FN(_wait_SCL)() ) {               /* Clock stretching */
+        return true;
+    }
+    
+    I2C_DELAY_HIGH(I2C_FN(_SPEED));
+    bit = I2C_FN(_read_SDA)();
+    I2C_FN(_clear_SCL)();
+    
+    return bit;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_write_byte
+* ------------------------
+*   Write a byte to the I2C Bus.
+*
+*   send_start: send a start condition
+*   send_stop:  send a stop condition
+*   byte:       byte to write
+*
+*   returns:    I2C_OK (acknowledge), I2C_ERROR_NACK or an error of the bus
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_write_byte)(bool send_start, bool send_stop, unsigned char byte)
+{
+    unsigned      bit;
+    bool          nack;
+    unsigned char sent = byte;                  /* Only used for the trace */
+    
+    
+    if (send_start) {
+        if (I2C_FN(_start)() != I2C_OK) {
+            return I2C_FN(_result);
+        }
+    } else {
+        I2C_FN(_result) = I2C_OK;
+    }
+    
+    for (bit = 0; bit < 8; ++bit) {
+        I2C_FN(_write_bit)((byte & 0x80) != 0);
+        if (I2C_FN(_result) != I2C_OK) {
+            return I2C_FN(_abort)();
+        }
+        byte <<= 1;
+    }
+    
+    nack = I2C_FN(_read_bit)();
+    if (I2C_FN(_result) != I2C_OK) {
+        return I2C_FN(_abort)();
+    }
+    
+    if (nack) {
+        I2C_TRACE1(TRACE_I2C_NACK, sent);
+    }
+    
+    if (send_stop) {
+        if (I2C_FN(_stop)() != I2C_OK) {
+            return I2C_FN(_result);
+        }
+    }
+    
+    return nack ? I2C_ERROR_NACK : I2C_OK;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_read_byte
+* ------------------------
+*   Read a byte from the I2C Bus.
+*
+*   nack:       send not acknowledge bit
+*   send_stop:  send a stop condition
+*   byte:       destination of the byte from slave
+*
+*   returns:    I2C_OK or an error of the bus
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_read_byte)(bool nack, bool send_stop, unsigned char *byte)
+{
+    unsigned char value = 0;
+    unsigned char bit;
+    
+    
+    I2C_FN(_result) = I2C_OK;
+    
+    for (bit = 0; bit < 8; ++bit) {
+        value = (value << 1) | I2C_FN(_read_bit)();
+        if (I2C_FN(_result) != I2C_OK) {
+            return I2C_FN(_abort)();
+        }
+    }
+    
+    I2C_FN(_write_bit)(nack);
+    if (I2C_FN(_result) != I2C_OK) {
+        return I2C_FN(_abort)();
+    }
+    
+    *byte = value;
+    
+    if (send_stop) {
+        return I2C_FN(_stop)();
+    }
+    
+    return I2C_OK;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_finish
+* --------------------
+*   End a transaction with a stop condition, unless the bus was already released by an error or
+*   a stop condition.
+*
+*   status: result of the transaction so far
+*
+*   returns: status, or the result of the stop condition if status is I2C_OK
+*
+***************************************************************************************************
+*/
+static I2C_status I2C_FN(_finish)(I2C_status status)
+{
+    I2C_status stop_status;
+    
+    
+    if ( !I2C_FN(_started) ) {
+        return status;
+    }
+    
+    stop_status = I2C_FN(_stop)();
+    
+    return (status != I2C_OK) ? status : stop_status;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_write
+* ------------------------
+*   Write a byte to the I2C slave with a 8 bit register.
+*
+*   slave_address:  slave address
+*   slave_register: slave register
+*   data_to_write:  byte to write
+*
+*   returns:        I2C_OK (write successful) or the reason why it failed
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_write)(unsigned char slave_address, unsigned char slave_register, unsigned char data_to_write)
+{
+    I2C_status status;
+    
+    
+    status = I2C_FN(_write_byte)(true, false, (slave_address | I2C_WRITE));              /* Start condition, slave address, write bit */
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_byte)(false, false, slave_register);                     /* Slave register */
+    }
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_byte)(false, false, data_to_write);                      /* Data */
+    }
+    
+    return I2C_FN(_finish)(status);                                                     /* Stop condition */
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_read
+* ------------------------
+*   Read a byte from the I2C slave with a 8 bit register.
+*
+*   slave_address:  slave address
+*   slave_register: slave register
+*   data:           destination of the byte from slave
+*
+*   returns:        I2C_OK (read successful) or the reason why it failed
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_read)(unsigned char slave_address, unsigned char slave_register, unsigned char *data)
+{
+    return I2C_FN(_read_burst)(slave_address, slave_register, data, 1);
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_write_16bit_addr
+* ------------------------------
+*   Write a byte to the I2C slave with a 16 bit register.
+*
+*   slave_address:          slave address
+*   slave_high_register:    first 8 bit of slave register
+*   slave_low_register:     second 8 bit of slave register
+*   data_to_write:          byte to write
+*
+*   returns:    I2C_OK (write successful) or the reason why it failed
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_write_16bit_addr)(unsigned char slave_address, unsigned char slave_high_register, unsigned char slave_low_register, unsigned char data_to_write)
+{
+    return I2C_FN(_write_burst_16bit_addr)(slave_address, slave_high_register, slave_low_register, &data_to_write, 1);
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_read_16bit_addr
+* ------------------------------
+*   Read a byte from the I2C slave with a 16 bit register.
+*
+*   slave_address:          slave address
+*   slave_high_register:    first 8 bit of slave register
+*   slave_low_register:     second 8 bit of slave register
+*   data:                   destination of the byte from slave
+*
+*   returns:    I2C_OK (read successful) or the reason why it failed
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_read_16bit_addr)(unsigned char slave_address, unsigned char slave_high_register, unsigned char slave_low_register, unsigned char *data)
+{
+    I2C_status status;
+    I2C_PROFILE_ENTER(I2C_FN(_PROFILE_READ_16BIT));
+    
+    
+    status = I2C_FN(_read_burst_16bit_addr)(slave_address, slave_high_register, slave_low_register, data, 1);
+    
+    I2C_PROFILE_EXIT(I2C_FN(_PROFILE_READ_16BIT));
+    return status;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_write_data
+* ------------------------
+*   Write bytes to the I2C Bus (no start or stop condition).
+*
+*   data:   bytes to write
+*   length: number of bytes
+*
+*   returns: I2C_OK (all bytes acknowledged), I2C_ERROR_NACK or an error of the bus
+*
+***************************************************************************************************
+*/
+static I2C_status I2C_FN(_write_data)(const unsigned char *data, unsigned int length)
+{
+    I2C_status status = I2C_OK;
+    
+    
+    while (length-- && (status == I2C_OK)) {
+        status = I2C_FN(_write_byte)(false, false, *data++);
+    }
+    return status;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_read_data
+* -----------------------
+*   Read bytes from the I2C Bus. Every byte except the last is acknowledged, the last one gets a
+*   not acknowledge and a stop condition.
+*
+*   data:   destination
+*   length: number of bytes (at least 1)
+*
+*   returns: I2C_OK or an error of the bus
+*
+***************************************************************************************************
+*/
+static I2C_status I2C_FN(_read_data)(unsigned char *data, unsigned int length)
+{
+    I2C_status status = I2C_OK;
+    
+    
+    while (--length && (status == I2C_OK)) {
+        status = I2C_FN(_read_byte)(false, false, data++);          /* Read data, send ACK */
+    }
+    if (status == I2C_OK) {
+        status = I2C_FN(_read_byte)(true, true, data);              /* Read data, send NACK, stop condition */
+    }
+    return status;
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_write_burst
+* -------------------------
+*   Write several bytes to the I2C slave with a 8 bit register in one transaction.
+*   The slave has to increment its register pointer itself (e.g. DS1307).
+*
+*   slave_address:  slave address
+*   slave_register: first slave register
+*   data:           bytes to write
+*   length:         number of bytes
+*
+*   returns:        I2C_OK (write successful) or the reason why it failed
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_write_burst)(unsigned char slave_address, unsigned char slave_register, const unsigned char *data, unsigned int length)
+{
+    I2C_status status;
+    
+    
+    status = I2C_FN(_write_byte)(true, false, (slave_address | I2C_WRITE));              /* Start condition, slave address, write bit */
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_byte)(false, false, slave_register);                     /* Slave register */
+    }
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_data)(data, length);                                     /* Data */
+    }
+    
+    return I2C_FN(_finish)(status);                                                     /* Stop condition */
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_read_burst
+* ------------------------
+*   Read several bytes from the I2C slave with a 8 bit register in one transaction.
+*
+*   slave_address:  slave address
+*   slave_register: first slave register
+*   data:           destination
+*   length:         number of bytes (at least 1)
+*
+*   returns:        I2C_OK (read successful) or the reason why it failed
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_read_burst)(unsigned char slave_address, unsigned char slave_register, unsigned char *data, unsigned int length)
+{
+    I2C_status status;
+    
+    
+    if (length == 0) {
+        return I2C_OK;
+    }
+    
+    status = I2C_FN(_write_byte)(true, false, (slave_address | I2C_WRITE));              /* Start condition, slave address, write bit */
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_byte)(false, false, slave_register);                     /* Slave register */
+    }
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_byte)(true, false, (slave_address | I2C_READ));          /* Start condition, slave address, read bit */
+    }
+    if (status == I2C_OK) {
+        status = I2C_FN(_read_data)(data, length);                                      /* Read data, stop condition */
+    }
+    
+    return I2C_FN(_finish)(status);
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_write_burst_16bit_addr
+* ------------------------------------
+*   Write several bytes to the I2C slave with a 16 bit register in one transaction.
+*   Note: EEPROMs like the AT24C32 wrap around at the end of a page.
+*
+*   slave_address:          slave address
+*   slave_high_register:    first 8 bit of slave register
+*   slave_low_register:     second 8 bit of slave register
+*   data:                   bytes to write
+*   length:                 number of bytes
+*
+*   returns:    I2C_OK (write successful) or the reason why it failed
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_write_burst_16bit_addr)(unsigned char slave_address, unsigned char slave_high_register, unsigned char slave_low_register, const unsigned char *data, unsigned int length)
+{
+    I2C_status status;
+    
+    
+    status = I2C_FN(_write_byte)(true, false, (slave_address | I2C_WRITE));              /* Start condition, slave address, write bit */
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_byte)(false, false, slave_high_register);                /* First 8 bit of slave register */
+    }
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_byte)(false, false, slave_low_register);                 /* Second 8 bit of slave register */
+    }
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_data)(data, length);                                     /* Data */
+    }
+    
+    return I2C_FN(_finish)(status);                                                     /* Stop condition */
+}
+
+/*
+***************************************************************************************************
+* Function: I2C_read_burst_16bit_addr
+* -----------------------------------
+*   Read several bytes from the I2C slave with a 16 bit register in one transaction.
+*
+*   slave_address:          slave address
+*   slave_high_register:    first 8 bit of slave register
+*   slave_low_register:     second 8 bit of slave register
+*   data:                   destination
+*   length:                 number of bytes (at least 1)
+*
+*   returns:    I2C_OK (read successful) or the reason why it failed
+*
+***************************************************************************************************
+*/
+I2C_status I2C_FN(_read_burst_16bit_addr)(unsigned char slave_address, unsigned char slave_high_register, unsigned char slave_low_register, unsigned char *data, unsigned int length)
+{
+    I2C_status status;
+    
+    
+    if (length == 0) {
+        return I2C_OK;
+    }
+    
+    status = I2C_FN(_write_byte)(true, false, (slave_address | I2C_WRITE));              /* Start condition, slave address, write bit */
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_byte)(false, false, slave_high_register);                /* First 8 bit of slave register */
+    }
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_byte)(false, false, slave_low_register);                 /* Second 8 bit of slave register */
+    }
+    if (status == I2C_OK) {
+        status = I2C_FN(_write_byte)(true, false, (slave_address | I2C_READ));          /* Start condition, slave address, read bit */
+    }
+    if (status == I2C_OK) {
+        status = I2C_FN(_read_data)(data, length);                                      /* Read data, stop condition */
+    }
+    
+    return I2C_FN(_finish)(status);
+}
+
+
+#undef I2C_PASTE
+#undef I2C_XPASTE
+#undef I2C_FN
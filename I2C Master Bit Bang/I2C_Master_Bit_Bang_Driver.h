@@ -20,7 +20,38 @@
 **                                         USER DEFINES
 ***************************************************************************************************
 */
+#ifndef F_CPU
 #define F_CPU   1000000UL           /* F_osc=8MHz & CKDIV=8 -> 8MHz / 8 = 1MHz */
+#endif
+
+/* CPU cycles spent in the driver code during SCL low / SCL high (function calls, port access,
+ * clock stretching check). They are subtracted from the delays. Counted by hand per instruction
+ * (sbi/cbi/lds 2, rcall 3, ret 4, branches 1-2 cycles) along the -Os code of the byte loops:
+ *   low:  ret, result check, shift, loop count, rcall, SDA set      write 26, read 21
+ *   high: rcall I2C_wait_SCL with one SCL check, ret, SDA sample   write 20, read 19
+ * The smaller path is used, so tLOW/tHIGH are never shorter than the delays. Not measured,
+ * check SCL with a scope (Host/i2c_sim reports the delay cycles per bit). */
+#define I2C_LOW_OVERHEAD_CYCLES     21
+#define I2C_HIGH_OVERHEAD_CYCLES    19
+
+/* CPU cycles of one pass of the clock stretching loop (read SCL, count down, branch), estimated */
+#define I2C_STRETCH_LOOP_CYCLES     8
+
+/* 1 -> I2C_read_16bit_addr is timed with Profile.h of the USART project (add ../USART to the
+ * include path, Profile.c and USART.c to the build and F_CPU=1000000UL to its symbols, USART.c
+ * is built for 8MHz otherwise), 0 -> no code */
+#define I2C_PROFILE                 0
+
+/* 1 -> NACK, arbitration loss, timeouts and bus errors are logged with Trace.h of the USART
+ * project (add ../USART to the include path, Trace.c and USART.c to the build and
+ * F_CPU=1000000UL to its symbols, USART.c is built for 8MHz otherwise), 0 -> no code */
+#define I2C_TRACE                   0
+
+/* Bus 1, functions I2C_... */
+#define I2C_SPEED       20000UL     /* SCL frequency in Hz: 100000 (Standard-mode), 400000 (Fast-mode) */
+                                    /* or any other value up to 400000. With F_CPU = 1MHz the code     */
+                                    /* reaches about 20kHz, 100kHz needs F_CPU = 8MHz (CKDIV = 1)      */
+#define I2C_TIMEOUT_US  1000UL      /* Max. clock stretching per SCL edge in us, then I2C_ERROR_TIMEOUT */
 
 #define I2C_SCL         4           /* SCL Bit */
 #define I2C_SCL_PORT    PORTA       /* SCL Port */
@@ -32,6 +63,21 @@
 #define I2C_SDA_DDR     DDRA
 #define I2C_SDA_PIN     PINA
 
+/* Bus 2, functions I2C2_... */
+#define I2C2_ENABLE     0           /* 1 -> second bus is built, 0 -> not built */
+#define I2C2_SPEED      20000UL
+#define I2C2_TIMEOUT_US 1000UL
+
+#define I2C2_SCL        0           /* SCL Bit */
+#define I2C2_SCL_PORT   PORTB       /* SCL Port */
+#define I2C2_SCL_DDR    DDRB
+#define I2C2_SCL_PIN    PINB
+
+#define I2C2_SDA        1           /* SDA Bit */
+#define I2C2_SDA_PORT   PORTB       /* SDA Port */
+#define I2C2_SDA_DDR    DDRB
+#define I2C2_SDA_PIN    PINB
+
 /* End of configuration options. Do not change followings without care.                          */
 /*************************************************************************************************/
 
@@ -43,19 +89,51 @@
 */
 
 
-#define I2C_DATA_HI()                                                                             \
-I2C_SDA_DDR &= ~(1 << I2C_SDA);     /* SDA as input, pull-up will pull SDA high */
-
-#define I2C_DATA_LO()                                                                             \
-I2C_SDA_DDR |= (1 << I2C_SDA);      /* SDA as output */                                           \
-I2C_SDA_PORT &= ~(1 << I2C_SDA);    /* Pull SDA low  */
-
-#define I2C_CLOCK_HI()                                                                            \
-I2C_SCL_DDR &= ~(1 << I2C_SCL);     /* SCL as input, pull-up will pull SCL high */
-
-#define I2C_CLOCK_LO()                                                                            \
-I2C_SCL_DDR |= (1 << I2C_SCL);      /* SCL as output */                                           \
-I2C_SCL_PORT &= ~(1 << I2C_SCL);    /* Pull SCL low  */
+/* Minimum bus timings in ns (I2C-bus specification UM10204, table 10), Fast-mode above 100kHz */
+#define I2C_FAST(speed)             ((speed) > 100000UL)
+#define I2C_T_LOW_NS(speed)         (I2C_FAST(speed) ? 1300UL : 4700UL)
+#define I2C_T_HIGH_NS(speed)        (I2C_FAST(speed) ? 600UL  : 4000UL)
+#define I2C_T_SU_STA_NS(speed)      (I2C_FAST(speed) ? 600UL  : 4700UL)
+#define I2C_T_HD_STA_NS(speed)      (I2C_FAST(speed) ? 600UL  : 4000UL)
+#define I2C_T_SU_STO_NS(speed)      (I2C_FAST(speed) ? 600UL  : 4000UL)
+#define I2C_T_BUF_NS(speed)         (I2C_FAST(speed) ? 1300UL : 4700UL)
+
+/* SCL period split 40% high / 60% low, but not below the minimum timings */
+#define I2C_PERIOD_NS(speed)        (1000000000UL / (speed))
+#define I2C_MAX(a, b)               (((a) > (b)) ? (a) : (b))
+#define I2C_HIGH_NS(speed)          I2C_MAX(I2C_T_HIGH_NS(speed), (I2C_PERIOD_NS(speed) * 4) / 10)
+#define I2C_LOW_NS(speed)           I2C_MAX(I2C_T_LOW_NS(speed), I2C_PERIOD_NS(speed) - I2C_HIGH_NS(speed))
+
+/* ns -> CPU cycles (rounded up) */
+#define I2C_NS_TO_CYCLES(ns)        (((ns) * (F_CPU / 1000UL) + 999999UL) / 1000000UL)
+#define I2C_CYCLES_MINUS(ns, cyc)   ((I2C_NS_TO_CYCLES(ns) > (cyc)) ? (I2C_NS_TO_CYCLES(ns) - (cyc)) : 0)
+
+/* Busy-wait delays, cycle exact and evaluated at compile time */
+#define I2C_DELAY_LOW(speed)        __builtin_avr_delay_cycles(I2C_CYCLES_MINUS(I2C_LOW_NS(speed), I2C_LOW_OVERHEAD_CYCLES))
+#define I2C_DELAY_HIGH(speed)       __builtin_avr_delay_cycles(I2C_CYCLES_MINUS(I2C_HIGH_NS(speed), I2C_HIGH_OVERHEAD_CYCLES))
+#define I2C_DELAY_SU_STA(speed)     __builtin_avr_delay_cycles(I2C_NS_TO_CYCLES(I2C_T_SU_STA_NS(speed)))
+#define I2C_DELAY_HD_STA(speed)     __builtin_avr_delay_cycles(I2C_NS_TO_CYCLES(I2C_T_HD_STA_NS(speed)))
+#define I2C_DELAY_SU_STO(speed)     __builtin_avr_delay_cycles(I2C_NS_TO_CYCLES(I2C_T_SU_STO_NS(speed)))
+#define I2C_DELAY_BUF(speed)        __builtin_avr_delay_cycles(I2C_NS_TO_CYCLES(I2C_T_BUF_NS(speed)))
+
+/* Passes of the clock stretching loop until a timeout */
+#define I2C_STRETCH_LOOPS(us)       (((us) * (F_CPU / 1000000UL)) / I2C_STRETCH_LOOP_CYCLES + 1)
+
+#define I2C_REACHABLE(speed)        ((I2C_NS_TO_CYCLES(I2C_LOW_NS(speed)) >= I2C_LOW_OVERHEAD_CYCLES) &&    \
+                                     (I2C_NS_TO_CYCLES(I2C_HIGH_NS(speed)) >= I2C_HIGH_OVERHEAD_CYCLES))
+
+/* Configuration checks */
+#if (I2C_SPEED > 400000UL) || (I2C2_ENABLE && (I2C2_SPEED > 400000UL))
+#error "I2C speed above 400kHz (Fast-mode Plus) is not supported"
+#endif
+
+#if !I2C_REACHABLE(I2C_SPEED) || (I2C2_ENABLE && !I2C_REACHABLE(I2C2_SPEED))
+#warning "I2C speed is not reachable with this F_CPU, the bus runs as fast as the code allows"
+#endif
+
+#if (I2C_STRETCH_LOOPS(I2C_TIMEOUT_US) > 65535UL) || (I2C2_ENABLE && (I2C_STRETCH_LOOPS(I2C2_TIMEOUT_US) > 65535UL))
+#error "I2C timeout is too long for this F_CPU"
+#endif
 
 #define I2C_READ    0x01
 #define I2C_WRITE   0x00
@@ -63,6 +141,16 @@ I2C_SCL_PORT &= ~(1 << I2C_SCL);    /* Pull SCL low  */
 #define I2C_ACK     0       /* Acknowledge     */
 #define I2C_NACK    1       /* Not Acknowledge */
 
+/* Result of a bus operation. Worst case, a transaction takes its nominal time plus one
+ * I2C_TIMEOUT_US (plus 9 clocks and a stop condition if the start has to recover the bus). */
+typedef enum {
+    I2C_OK = 0,                     /* Done, every byte acknowledged                                  */
+    I2C_ERROR_NACK,                 /* Slave sent not acknowledge                                     */
+    I2C_ERROR_TIMEOUT,              /* SCL held low longer than the timeout, both lines are released  */
+    I2C_ERROR_ARBITRATION,          /* SDA low while the master sent a 1, both lines are released     */
+    I2C_ERROR_BUS                   /* SDA stuck low, also after I2C_recover                          */
+} I2C_status;
+
 
 /*
 ***************************************************************************************************
@@ -73,13 +161,44 @@ I2C_SCL_PORT &= ~(1 << I2C_SCL);    /* Pull SCL low  */
 #include <util/delay.h>
 #include <stdbool.h>
 
-
-/*
-***************************************************************************************************
-**                                  GLOBAL VARIABLES AND ARRAYS
-***************************************************************************************************
-*/
-bool I2C_started;
+/* Hooks of the USART project, own names so Profile.h and Trace.h can be included anyway */
+#if I2C_PROFILE
+#include "Profile.h"
+#define I2C_PROFILE_ENTER(site)     PROFILE_ENTER(site)
+#define I2C_PROFILE_EXIT(site)      PROFILE_EXIT(site)
+#else
+#define I2C_PROFILE_ENTER(site)     do { } while (0)    /* Both need the semicolon in every build */
+#define I2C_PROFILE_EXIT(site)      do { } while (0)
+#endif
+
+#if I2C_TRACE
+#include "Trace.h"
+#define I2C_TRACE0(id)              TRACE0(id)
+#define I2C_TRACE1(id, a)           TRACE1(id, a)
+#else
+#define I2C_TRACE0(id)              do { } while (0)
+#define I2C_TRACE1(id, a)           do { (void)(a); } while (0)
+#endif
+
+
+/* Function prototypes of one bus, bus: I2C or I2C2 */
+#define I2C_PROTOTYPES(bus)                                                                       \
+void bus##_init(void);                                                                            \
+I2C_status bus##_recover(void);                                                                   \
+I2C_status bus##_start(void);                                                                     \
+I2C_status bus##_stop(void);                                                                      \
+void bus##_write_bit(bool bit);                                                                   \
+bool bus##_read_bit(void);                                                                        \
+I2C_status bus##_write_byte(bool send_start, bool send_stop, unsigned char byte);                 \
+I2C_status bus##_read_byte(bool nack, bool send_stop, unsigned char *byte);                       \
+I2C_status bus##_write(unsigned char slave_address, unsigned char slave_register, unsigned char data_to_write);                \
+I2C_status bus##_read(unsigned char slave_address, unsigned char slave_register, unsigned char *data);                         \
+I2C_status bus##_write_16bit_addr(unsigned char slave_address, unsigned char slave_high_register, unsigned char slave_low_register, unsigned char data_to_write);    \
+I2C_status bus##_read_16bit_addr(unsigned char slave_address, unsigned char slave_high_register, unsigned char slave_low_register, unsigned char *data);             \
+I2C_status bus##_write_burst(unsigned char slave_address, unsigned char slave_register, const unsigned char *data, unsigned int length);                        \
+I2C_status bus##_read_burst(unsigned char slave_address, unsigned char slave_register, unsigned char *data, unsigned int length);                               \
+I2C_status bus##_write_burst_16bit_addr(unsigned char slave_address, unsigned char slave_high_register, unsigned char slave_low_register, const unsigned char *data, unsigned int length);  \
+I2C_status bus##_read_burst_16bit_addr(unsigned char slave_address, unsigned char slave_high_register, unsigned char slave_low_register, unsigned char *data, unsigned int length);
 
 
 /*
@@ -88,25 +207,14 @@ bool I2C_started;
 ***************************************************************************************************
 */
 void init_ATtiny841_board(void);
-void I2C_init(void);
-bool read_SCL(void);
-bool read_SDA(void);
-void set_SCL(void);
-void clear_SCL(void);
-void set_SDA(void);
-void clear_SDA(void);
-void arbitration_lost(void);
-void I2C_start(void);
-void I2C_stop(void);
-void I2C_write_bit(bool bit);
-bool I2C_read_bit(void);
-bool I2C_write_byte(bool send_start, bool send_stop, unsigned char byte);
-unsigned char I2C_read_byte(bool nack, bool send_stop);
-bool I2C_write(unsigned char slave_address, unsigned char slave_register, unsigned char data_to_write);
-unsigned char I2C_read(unsigned char slave_address, unsigned char slave_register);
-bool I2C_write_16bit_addr(unsigned char slave_address, unsigned char slave_high_register, unsigned char slave_low_register, unsigned char data_to_write);
-unsigned char I2C_read_16bit_addr(unsigned char slave_address, unsigned char slave_high_register, unsigned char slave_low_register);
+I2C_PROTOTYPES(I2C)
+
+#if I2C2_ENABLE
+I2C_PROTOTYPES(I2C2)
+#endif
+
 unsigned char BCD_to_decimal(unsigned char bcd);
+unsigned char decimal_to_BCD(unsigned char decimal);
 
 
 
@@ -0,0 +1,479 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: I2C_Parallel.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a bit-parallel I2C Master Bit Bang Driver. One SCL line is shared by up to
+*              7 SDA lines (lanes) on the same port, so several slaves with the same address
+*              are accessed at the same time. Every bit is written with one access to the DDR
+*              register and sampled with one read of the PIN register for all lanes.
+*
+*              All lanes get the same address, register and data bytes. Results are returned
+*              per lane: a bit mask of the lanes that did not acknowledge and one data byte per
+*              lane, indexed by the SDA bit number.
+*
+*              Single master only, there is no arbitration check. Clock stretching is bounded
+*              by I2CP_TIMEOUT_US like on the single bus: on a timeout both lines are released,
+*              all lanes are reported as failed and I2CP_status returns I2C_ERROR_TIMEOUT.
+*
+***************************************************************************************************
+*/
+
+#include "I2C_Parallel.h"
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static bool       I2CP_started = false;
+static I2C_status I2CP_result = I2C_OK;                 /* Status of the current transaction */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Pin operations
+* --------------
+*   Open drain like the single bus driver: PORT bits stay 0, a line is pulled low by switching
+*   it to output and released by switching it to input.
+*
+***************************************************************************************************
+*/
+static inline void I2CP_set_SCL(void)
+{
+    I2CP_DDR &= ~(1 << I2CP_SCL);
+}
+
+static inline void I2CP_clear_SCL(void)
+{
+    I2CP_DDR |= (1 << I2CP_SCL);
+}
+
+static inline bool I2CP_read_SCL(void)
+{
+    return (I2CP_PIN & (1 << I2CP_SCL)) != 0;
+}
+
+static inline void I2CP_set_SDA(void)
+{
+    I2CP_DDR &= ~I2CP_SDA_MASK;                         /* Release all lanes */
+}
+
+static inline void I2CP_clear_SDA(void)
+{
+    I2CP_DDR |= I2CP_SDA_MASK;                          /* Pull all lanes low */
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_init
+* -------------------
+*   Release SCL and all SDA lines.
+*
+***************************************************************************************************
+*/
+void I2CP_init(void)
+{
+    I2CP_PORT &= ~(I2CP_SDA_MASK | (1 << I2CP_SCL));  /* Output level is always low */
+    I2CP_set_SCL();
+    I2CP_set_SDA();
+    
+    _delay_us(10);
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_wait_SCL
+* -----------------------
+*   Wait until SCL is high (clock stretching), at most I2CP_TIMEOUT_US.
+*
+*   returns: true (SCL high) or false (timeout, the result is I2C_ERROR_TIMEOUT)
+*
+***************************************************************************************************
+*/
+static bool I2CP_wait_SCL(void)
+{
+    unsigned int loops = I2C_STRETCH_LOOPS(I2CP_TIMEOUT_US);
+    
+    
+    while (I2CP_read_SCL() == 0) {
+        if (--loops == 0) {
+            I2CP_result = I2C_ERROR_TIMEOUT;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_abort
+* --------------------
+*   Release all lines after a timeout. The next transaction starts with a new start condition.
+*
+*   returns: I2C_status of the failed operation
+*
+***************************************************************************************************
+*/
+static I2C_status I2CP_abort(void)
+{
+    I2CP_set_SCL();
+    I2CP_set_SDA();
+    I2CP_started = false;
+    
+    return I2CP_result;
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_recover
+* ----------------------
+*   Bus recovery like I2C_recover: lanes that hold SDA low get up to 9 clocks to finish their
+*   byte, then a stop condition puts all slaves back into idle.
+*
+*   returns: I2C_OK, I2C_ERROR_TIMEOUT or I2C_ERROR_BUS (a lane still low)
+*
+***************************************************************************************************
+*/
+static I2C_status I2CP_recover(void)
+{
+    unsigned char clocks;
+    
+    
+    I2CP_set_SDA();
+    
+    for (clocks = 0; (clocks < 9) && ((I2CP_PIN & I2CP_SDA_MASK) != I2CP_SDA_MASK); ++clocks) {
+        I2CP_clear_SCL();
+        I2C_DELAY_LOW(I2CP_SPEED);
+        I2CP_set_SCL();
+        if ( !I2CP_wait_SCL() ) {
+            return I2CP_abort();
+        }
+        I2C_DELAY_HIGH(I2CP_SPEED);
+    }
+    
+    I2CP_clear_SCL();
+    return I2CP_stop();
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_start
+* --------------------
+*   Do a start (or restart) condition on all lanes. If a lane holds SDA low, the bus is
+*   recovered first.
+*
+*   returns: I2C_OK, I2C_ERROR_TIMEOUT or I2C_ERROR_BUS
+*
+***************************************************************************************************
+*/
+I2C_status I2CP_start(void)
+{
+    I2CP_result = I2C_OK;
+    
+    if (I2CP_started) {                 /* If I2C has started, do a restart condition */
+        I2CP_set_SDA();
+        I2C_DELAY_LOW(I2CP_SPEED);
+        I2CP_set_SCL();
+        if ( !I2CP_wait_SCL() ) {       /* Clock stretching */
+            return I2CP_abort();
+        }
+        
+        I2C_DELAY_SU_STA(I2CP_SPEED);
+    } else if ( !I2CP_wait_SCL() ) {   /* SCL held low on an idle bus */
+        return I2CP_abort();
+    }
+    
+    if ((I2CP_PIN & I2CP_SDA_MASK) != I2CP_SDA_MASK) {
+        I2CP_started = false;
+        if (I2CP_recover() != I2C_OK) {
+            return I2CP_result;
+        }
+    }
+    
+    I2CP_clear_SDA();                   /* SCL is high, set SDA from 1 to 0 to start */
+    I2C_DELAY_HD_STA(I2CP_SPEED);
+    I2CP_clear_SCL();
+    I2CP_started = true;
+    
+    return I2C_OK;
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_stop
+* -------------------
+*   Do a stop condition on all lanes.
+*
+*   returns: I2C_OK, I2C_ERROR_TIMEOUT or I2C_ERROR_BUS (a lane still low after the stop)
+*
+***************************************************************************************************
+*/
+I2C_status I2CP_stop(void)
+{
+    I2CP_result = I2C_OK;
+    
+    I2CP_clear_SDA();
+    I2C_DELAY_LOW(I2CP_SPEED);
+    I2CP_set_SCL();
+    if ( !I2CP_wait_SCL() ) {           /* Clock stretching */
+        return I2CP_abort();
+    }
+    I2C_DELAY_SU_STO(I2CP_SPEED);
+    I2CP_set_SDA();                     /* SCL is high, set SDA from 0 to 1 to stop */
+    I2C_DELAY_BUF(I2CP_SPEED);
+    I2CP_started = false;
+    
+    if ((I2CP_PIN & I2CP_SDA_MASK) != I2CP_SDA_MASK) {
+        I2CP_result = I2C_ERROR_BUS;
+    }
+    
+    return I2CP_result;
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_status
+* ---------------------
+*   returns: I2C_status of the last start, stop, byte or transaction. With an error all lanes
+*            are reported as failed by the functions that return a lane mask.
+*
+***************************************************************************************************
+*/
+I2C_status I2CP_status(void)
+{
+    return I2CP_result;
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_clock
+* --------------------
+*   Clock one bit. SDA has to be set before. On a timeout the result is I2C_ERROR_TIMEOUT and SCL
+*   is left released.
+*
+*   returns: PIN register sampled while SCL is high, masked to the SDA lanes
+*
+***************************************************************************************************
+*/
+static unsigned char I2CP_clock(void)
+{
+    unsigned char sample;
+    
+    
+    I2C_DELAY_LOW(I2CP_SPEED);
+    I2CP_set_SCL();
+    
+    if ( !I2CP_wait_SCL() ) {           /* Clock stretching */
+        return I2CP_SDA_MASK;
+    }
+    
+    I2C_DELAY_HIGH(I2CP_SPEED);
+    sample = I2CP_PIN & I2CP_SDA_MASK;  /* One read for all lanes */
+    I2CP_clear_SCL();
+    
+    return sample;
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_write_byte
+* -------------------------
+*   Write the same byte on all lanes.
+*
+*   send_start: send a start condition
+*   send_stop:  send a stop condition
+*   byte:       byte to write
+*
+*   returns:    mask of the lanes that sent not acknowledge (0 -> all acknowledged), all lanes
+*               on an error of the bus (see I2CP_status)
+*
+***************************************************************************************************
+*/
+unsigned char I2CP_write_byte(bool send_start, bool send_stop, unsigned char byte)
+{
+    unsigned char bit;
+    unsigned char nack;
+    
+    
+    if (send_start) {
+        if (I2CP_start() != I2C_OK) {
+            return I2CP_SDA_MASK;
+        }
+    } else {
+        I2CP_result = I2C_OK;
+    }
+    
+    for (bit = 0; bit < 8; ++bit) {
+        if (byte & 0x80) {
+            I2CP_set_SDA();
+        } else {
+            I2CP_clear_SDA();
+        }
+        I2CP_clock();
+        if (I2CP_result != I2C_OK) {
+            I2CP_abort();
+            return I2CP_SDA_MASK;
+        }
+        byte <<= 1;
+    }
+    
+    I2CP_set_SDA();                     /* Release SDA, slaves acknowledge */
+    nack = I2CP_clock();
+    if (I2CP_result != I2C_OK) {
+        I2CP_abort();
+        return I2CP_SDA_MASK;
+    }
+    
+    if (send_stop) {
+        if (I2CP_stop() != I2C_OK) {
+            return I2CP_SDA_MASK;
+        }
+    }
+    
+    return nack;
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_read_byte
+* ------------------------
+*   Read one byte from every lane. The 8 samples are transposed to one byte per lane at the end.
+*
+*   nack:       send not acknowledge bit
+*   send_stop:  send a stop condition
+*   data:       destination, data[n] is the byte of the lane on SDA bit n
+*
+*   returns:    I2C_OK or an error of the bus, data is not written then
+*
+***************************************************************************************************
+*/
+I2C_status I2CP_read_byte(bool nack, bool send_stop, unsigned char data[I2CP_LANES])
+{
+    unsigned char sample[8];
+    unsigned char bit;
+    unsigned char lane;
+    unsigned char byte;
+    
+    
+    I2CP_result = I2C_OK;
+    I2CP_set_SDA();
+    
+    for (bit = 0; bit < 8; ++bit) {
+        sample[bit] = I2CP_clock();
+        if (I2CP_result != I2C_OK) {
+            return I2CP_abort();
+        }
+    }
+    
+    if (!nack) {
+        I2CP_clear_SDA();               /* Acknowledge on all lanes */
+    }
+    I2CP_clock();
+    if (I2CP_result != I2C_OK) {
+        return I2CP_abort();
+    }
+    
+    if (send_stop) {
+        if (I2CP_stop() != I2C_OK) {
+            return I2CP_result;
+        }
+    }
+    
+    for (lane = 0; lane < I2CP_LANES; ++lane) {
+        if (I2CP_SDA_MASK & (1 << lane)) {
+            byte = 0;
+            for (bit = 0; bit < 8; ++bit) {
+                byte = (byte << 1) | ((sample[bit] >> lane) & 0x01);
+            }
+            data[lane] = byte;
+        }
+    }
+    
+    return I2C_OK;
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_write
+* --------------------
+*   Write a byte to the slaves on all lanes with a 8 bit register.
+*
+*   slave_address:  slave address
+*   slave_register: slave register
+*   data_to_write:  byte to write
+*
+*   returns:        mask of the lanes where the write was not successful (0 -> all successful),
+*                   all lanes on an error of the bus (see I2CP_status)
+*
+***************************************************************************************************
+*/
+unsigned char I2CP_write(unsigned char slave_address, unsigned char slave_register, unsigned char data_to_write)
+{
+    unsigned char nack;
+    
+    
+    nack  = I2CP_write_byte(true, false, (slave_address | I2C_WRITE));      /* Start condition, slave address, write bit */
+    if (I2CP_result == I2C_OK) {
+        nack |= I2CP_write_byte(false, false, slave_register);              /* Slave register */
+    }
+    if (I2CP_result == I2C_OK) {
+        nack |= I2CP_write_byte(false, true, data_to_write);                /* Data, stop condition */
+    }
+    
+    return nack;
+}
+
+/*
+***************************************************************************************************
+* Function: I2CP_read
+* -------------------
+*   Read a byte from the slaves on all lanes with a 8 bit register.
+*
+*   slave_address:  slave address
+*   slave_register: slave register
+*   data:           destination, data[n] is the byte of the lane on SDA bit n
+*
+*   returns:        mask of the lanes where the read was not successful (0 -> all successful),
+*                   all lanes on an error of the bus (see I2CP_status)
+*
+***************************************************************************************************
+*/
+unsigned char I2CP_read(unsigned char slave_address, unsigned char slave_register, unsigned char data[I2CP_LANES])
+{
+    unsigned char nack;
+    
+    
+    nack  = I2CP_write_byte(true, false, (slave_address | I2C_WRITE));      /* Start condition, slave address, write bit */
+    if (I2CP_result == I2C_OK) {
+        nack |= I2CP_write_byte(false, false, slave_register);              /* Slave register */
+    }
+    if (I2CP_result == I2C_OK) {
+        nack |= I2CP_write_byte(true, false, (slave_address | I2C_READ));   /* Start condition, slave address, read bit */
+    }
+    
+    if (I2CP_result != I2C_OK) {
+        return I2CP_SDA_MASK;                                               /* Lines are released */
+    }
+    
+    if (nack == I2CP_SDA_MASK) {
+        I2CP_stop();                                                        /* Nobody answered */
+        return nack;
+    }
+    
+    if (I2CP_read_byte(true, true, data) != I2C_OK) {                       /* Read data, send NACK, stop condition */
+        return I2CP_SDA_MASK;
+    }
+    
+    return nack;
+}
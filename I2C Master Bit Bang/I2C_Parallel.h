@@ -0,0 +1,77 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: I2C_Parallel.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for I2C_Parallel.c
+*
+***************************************************************************************************
+*/
+
+#ifndef I2C_PARALLEL_H_
+#define I2C_PARALLEL_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define I2CP_SPEED      100000UL    /* SCL frequency in Hz, up to 400000 */
+#define I2CP_TIMEOUT_US 1000UL      /* Max. clock stretching per SCL edge in us, then I2C_ERROR_TIMEOUT */
+
+#define I2CP_PORT       PORTA       /* SCL and all SDA lines are on this port */
+#define I2CP_DDR        DDRA
+#define I2CP_PIN        PINA
+
+#define I2CP_SCL        7           /* Shared SCL Bit */
+#define I2CP_SDA_MASK   0b00001111  /* One SDA line (lane) per bit, up to 7 lanes */
+
+/* End of configuration options. Do not change followings without care.                          */
+/*************************************************************************************************/
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#if (I2CP_SDA_MASK & (1 << I2CP_SCL)) || (I2CP_SDA_MASK == 0)
+#error "I2CP_SDA_MASK must not be empty and must not contain I2CP_SCL"
+#endif
+
+#define I2CP_LANES      8           /* Size of the per-lane data arrays, index = SDA bit number */
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include "I2C_Master_Bit_Bang_Driver.h"
+
+/* F_CPU and I2C_STRETCH_LOOPS come with the bit-bang driver header */
+#if I2C_STRETCH_LOOPS(I2CP_TIMEOUT_US) > 65535UL
+#error "I2CP_TIMEOUT_US is too long for F_CPU"
+#endif
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+void I2CP_init(void);
+I2C_status I2CP_start(void);
+I2C_status I2CP_stop(void);
+I2C_status I2CP_status(void);
+unsigned char I2CP_write_byte(bool send_start, bool send_stop, unsigned char byte);
+I2C_status I2CP_read_byte(bool nack, bool send_stop, unsigned char data[I2CP_LANES]);
+unsigned char I2CP_write(unsigned char slave_address, unsigned char slave_register, unsigned char data_to_write);
+unsigned char I2CP_read(unsigned char slave_address, unsigned char slave_register, unsigned char data[I2CP_LANES]);
+
+
+#endif /* I2C_PARALLEL_H_ */
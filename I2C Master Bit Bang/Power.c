@@ -0,0 +1,54 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Power.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Sleep between the I2C transactions.
+*              The bit-bang driver is synchronous, so no I2C work is pending when the main loop
+*              calls POWER_sleep. The CPU goes to Power-down and wakes on a pin change (e.g. the
+*              SQW output of the DS1307), INT0 or the watchdog. Only I2C_Async needs the clock
+*              between its Timer1 ticks, it gets Idle instead.
+*
+***************************************************************************************************
+*/
+
+#include "Power.h"
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: POWER_sleep
+* ---------------------
+*   Sleep until the next interrupt. A wake-up source must be enabled, otherwise Power-down
+*   lasts until reset.
+*
+***************************************************************************************************
+*/
+void POWER_sleep(void)
+{
+    unsigned char mode = SLEEP_MODE_PWR_DOWN;
+    
+    
+    cli();                                              /* A wake-up now must not be missed */
+    
+#if POWER_I2C_ASYNC
+    if (!I2C_async_idle()) {
+        mode = SLEEP_MODE_IDLE;
+    }
+#endif
+    
+    set_sleep_mode(mode);
+    sleep_enable();
+    sei();                                              /* The next instruction is executed before */
+    sleep_cpu();                                        /* any interrupt, so no wake-up is lost    */
+    sleep_disable();
+}
@@ -0,0 +1,52 @@
+/*
+***************************************************************************************************
+* Project:  I2C Master Bit Bang Driver
+* Filename: Power.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for Power.c
+*
+***************************************************************************************************
+*/
+
+#ifndef POWER_H_
+#define POWER_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define POWER_I2C_ASYNC         0           /* 1 -> I2C_Async is used, POWER_sleep stays in Idle  */
+                                            /*      while transactions run (Timer1 needs a clock) */
+
+/* End of configuration options. Do not change followings without care.                          */
+/*************************************************************************************************/
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#if POWER_I2C_ASYNC
+#include "I2C_Async.h"
+#endif
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+void POWER_sleep(void);
+
+
+#endif /* POWER_H_ */
@@ -8,13 +8,19 @@
 *
 * Description: This is a test program for the I2C Master Bit Bang Driver.
 *              Tested with ATtiny841, RTC DS1307 and EEPROM AT24C32.
-*              Have a look at the Main loop for an example.
+*              Have a look at the Main loop for an example. It does not use the scheduler of
+*              the Scheduler project: its tick (Timer0) stops in Power-down, and the CPU sleeps in
+*              Power-down here until the SQW output of the DS1307 wakes it once a second.
 *
 ***************************************************************************************************
 */
 
 #include "main.h"
 #include "I2C_Master_Bit_Bang_Driver.h"
+#include "AT24C32.h"
+#include "I2C_Cache.h"
+#include "DS1307.h"
+#include "Power.h"
 
 
 /*
@@ -22,7 +28,10 @@
 **                                  GLOBAL VARIABLES AND ARRAYS
 ***************************************************************************************************
 */
-// Initialize global variables or arrays here
+/* DS1307 registers 0x00...0x0F: time registers 0x00...0x06 count by themselves, control and RAM
+ * only change when written */
+static const unsigned char rtc_volatile[2] = { 0x7F, 0x00 };
+I2C_CACHE_DEVICE(rtc_cache, RTC_DS1307_ADDRESS, 0x00, 16, rtc_volatile);
 
 
 /*
@@ -35,28 +44,41 @@ int main(void)
     /* Local variables */
     volatile unsigned char test1 = 0;    /* for debugging */
     volatile unsigned char test2 = 0;    /* for debugging */
-    volatile bool result1 = 0;           /* for debugging */
-    volatile bool result2 = 0;           /* for debugging */
+    volatile I2C_status result1 = I2C_OK;    /* for debugging */
+    volatile I2C_status result2 = I2C_OK;    /* for debugging */
+    unsigned char time[1];               /* for debugging */
+    unsigned char eeprom_data[1];        /* for debugging */
+    DS1307_time now;                     /* for debugging */
+    bool rtc_ticking;
     
     /* Initializations */
     ATtiny841_board_init();
     I2C_init();
+    rtc_ticking = (DS1307_init() == I2C_OK);     /* SQW wakes the CPU once a second */
     
     
     /* Main loop */
     while(1)
     {
         result1 = I2C_write(RTC_DS1307_ADDRESS, 0x08, 0x55);     /* for debugging */
-        _delay_ms(1);
-        test1 = I2C_read(RTC_DS1307_ADDRESS, 0x08);              /* for debugging, returns 0x55 if successful */
+        result1 = I2C_read(RTC_DS1307_ADDRESS, 0x08, time);      /* for debugging */
+        test1 = time[0];                                         /* for debugging, 0x55 if successful */
         
-        _delay_ms(5);
+        result1 = I2C_cache_write(&rtc_cache, 0x09, 0xA5);       /* for debugging */
+        result1 = I2C_cache_read(&rtc_cache, 0x09, time);        /* for debugging, from SRAM, rtc_cache.hits counts up */
         
-        result2 = I2C_write_16bit_addr(EEPROM_AT24C32_ADDRESS, 0x00, 0x00, 0xAA);     /* for debugging */
-        _delay_ms(1);
-        test2 = I2C_read_16bit_addr(EEPROM_AT24C32_ADDRESS, 0x00, 0x00);              /* for debugging, returns 0xAA if successful */
+        eeprom_data[0] = 0xAA;
+        result2 = AT24C32_write(0x0000, eeprom_data, 1);     /* for debugging */
+        AT24C32_read(0x0000, eeprom_data, 1);                /* for debugging, waits only until the write cycle is done */
+        test2 = eeprom_data[0];                              /* for debugging, 0xAA if successful */
         
-        _delay_ms(10);
+        result1 = DS1307_get_time(&now);     /* for debugging, local time, the RTC is only read once an hour */
+        
+        if (rtc_ticking) {
+            POWER_sleep();                   /* Power-down until the next second */
+        } else {
+            _delay_ms(10);                   /* No wake-up source without the RTC */
+        }
         
     } /* while(1) */
 } /* Main */
@@ -67,6 +89,7 @@ int main(void)
 * Function: ATtiny841_board_init
 * ------------------------------
 *   Initializes the ports of the ATtiny841-board
+*   All peripherals are turned off, the drivers turn on what they use
 *
 ***************************************************************************************************
 */
@@ -80,4 +103,8 @@ void ATtiny841_board_init(void)
     
     PORTA = 0b00000000;
     PORTB = 0b00000000;
+    
+    PRR = (1<<PRTWI)|(1<<PRUSART1)|(1<<PRUSART0)|(1<<PRSPI)|(1<<PRTIM2)|(1<<PRTIM1)|(1<<PRTIM0)|(1<<PRADC);
+    ACSR0A = (1<<ACD0);                 /* Analog comparators off */
+    ACSR1A = (1<<ACD1);
 }
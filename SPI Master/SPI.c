@@ -0,0 +1,316 @@
+/*
+***************************************************************************************************
+* Project:  SPI Master
+* Filename: SPI.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a SPI master driver for the hardware SPI of the ATtiny841.
+*              Every slave is described by an SPI_device (chip select pin, mode, bit order,
+*              clock divider), the SPI is set up for the device when it is selected.
+*
+*              SPI_transfer / SPI_exchange: polled, for short transfers and fast clocks. The next
+*              byte is prepared while the current one is shifted and written to SPDR right after
+*              SPIF (the receive side is double buffered), so bulk transfers at F_CPU/2 only
+*              have the few cycles of the SPIF poll between the bytes.
+*              SPI_transfer_async: driven by the SPI interrupt, for long transfers at slow clocks
+*              where the CPU has time between the bytes. The chip select is released in the ISR.
+*
+***************************************************************************************************
+*/
+
+#include "SPI.h"
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static const unsigned char  SPI_fill = SPI_FILL;
+static unsigned char        SPI_discard;                    /* Receive target without rx buffer */
+
+/* Running asynchronous transfer, written by the ISR */
+static const SPI_device    *volatile SPI_async_device = 0;  /* NULL -> no transfer */
+static const unsigned char *SPI_async_tx;
+static unsigned char        SPI_async_tx_step;
+static unsigned char       *SPI_async_rx;
+static unsigned char        SPI_async_rx_step;
+static unsigned int         SPI_async_length;
+static void               (*SPI_async_callback)(const SPI_device *device);
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: SPI_init
+* ------------------
+*   Initializes the SPI as master: power on (PRR), SCK, MOSI and SS as outputs, MISO as input.
+*   The devices are set up with SPI_device_init.
+*
+***************************************************************************************************
+*/
+void SPI_init(void)
+{
+    PRR &= ~(1<<PRSPI);
+    
+    SPI_DDR |= (1<<SPI_SCK)|(1<<SPI_MOSI)|(1<<SPI_SS);
+    SPI_DDR &= ~(1<<SPI_MISO);
+    
+    SPCR = (1<<SPE)|(1<<MSTR);
+    
+    sei();
+}
+
+/*
+***************************************************************************************************
+* Function: SPI_disable
+* ---------------------
+*   Turn the SPI off (also in PRR) after the running transfer. SPI_init turns it on again.
+*
+***************************************************************************************************
+*/
+void SPI_disable(void)
+{
+    while (SPI_busy());
+    
+    SPCR = 0;
+    PRR |= (1<<PRSPI);
+}
+
+/*
+***************************************************************************************************
+* Function: SPI_device_init
+* -------------------------
+*   Chip select of a device as output, not selected (high).
+*
+*   device: device descriptor
+*
+***************************************************************************************************
+*/
+void SPI_device_init(const SPI_device *device)
+{
+    *device->cs_port |= device->cs_mask;
+    *device->cs_ddr  |= device->cs_mask;
+}
+
+/*
+***************************************************************************************************
+* Function: SPI_select
+* --------------------
+*   Wait for a running asynchronous transfer, set mode, bit order and clock of the device and
+*   pull its chip select low. For commands that are sent in parts, e.g. opcode with
+*   SPI_exchange_byte, then the data with SPI_exchange.
+*
+*   device: device descriptor
+*
+***************************************************************************************************
+*/
+void SPI_select(const SPI_device *device)
+{
+    while (SPI_busy());
+    
+    SPCR = device->spcr;
+    SPSR = device->spi2x << SPI2X;
+    *device->cs_port &= ~device->cs_mask;
+}
+
+/*
+***************************************************************************************************
+* Function: SPI_deselect
+* ----------------------
+*   Release the chip select of the device.
+*
+*   device: device descriptor
+*
+***************************************************************************************************
+*/
+void SPI_deselect(const SPI_device *device)
+{
+    *device->cs_port |= device->cs_mask;
+}
+
+/*
+***************************************************************************************************
+* Function: SPI_exchange_byte
+* ---------------------------
+*   Send and receive one byte (polled). A device must be selected.
+*
+*   byte: byte to send
+*
+*   returns: received byte
+*
+***************************************************************************************************
+*/
+unsigned char SPI_exchange_byte(unsigned char byte)
+{
+    SPDR = byte;
+    while ( !(SPSR & (1<<SPIF)) );
+    
+    return SPDR;
+}
+
+/*
+***************************************************************************************************
+* Function: SPI_exchange
+* ----------------------
+*   Full-duplex transfer of length bytes (polled). A device must be selected.
+*   The pointers step by 0 instead of 1 without a buffer, so the loop has no branches except
+*   the SPIF poll.
+*
+*   tx:     bytes to send or NULL (SPI_FILL is sent)
+*   rx:     destination of the received bytes or NULL
+*   length: number of bytes
+*
+***************************************************************************************************
+*/
+void SPI_exchange(const unsigned char *tx, unsigned char *rx, unsigned int length)
+{
+    unsigned char tx_step = tx ? 1 : 0;
+    unsigned char rx_step = rx ? 1 : 0;
+    unsigned char next;
+    
+    
+    if (length == 0) {
+        return;
+    }
+    if (!tx) {
+        tx = &SPI_fill;
+    }
+    if (!rx) {
+        rx = &SPI_discard;
+    }
+    
+    SPDR = *tx;
+    tx += tx_step;
+    
+    while (--length) {
+        next = *tx;                                     /* Ready before the current byte is done */
+        tx += tx_step;
+        
+        while ( !(SPSR & (1<<SPIF)) );
+        SPDR = next;                                    /* Starts the next byte at once ...       */
+        *rx = SPDR;                                     /* ... the previous one stays readable    */
+        rx += rx_step;
+    }
+    
+    while ( !(SPSR & (1<<SPIF)) );
+    *rx = SPDR;
+}
+
+/*
+***************************************************************************************************
+* Function: SPI_transfer
+* ----------------------
+*   Select the device, full-duplex transfer of length bytes (polled), release the device.
+*
+*   device: device descriptor
+*   tx:     bytes to send or NULL (SPI_FILL is sent)
+*   rx:     destination of the received bytes or NULL
+*   length: number of bytes
+*
+***************************************************************************************************
+*/
+void SPI_transfer(const SPI_device *device, const unsigned char *tx, unsigned char *rx, unsigned int length)
+{
+    SPI_select(device);
+    SPI_exchange(tx, rx, length);
+    SPI_deselect(device);
+}
+
+/*
+***************************************************************************************************
+* Function: SPI_transfer_async
+* ----------------------------
+*   Start a transfer driven by the SPI interrupt and return at once. The device is selected
+*   now and released by the ISR after the last byte, then the callback is called (from the
+*   ISR). The buffers must stay valid until SPI_busy returns false.
+*
+*   device:   device descriptor
+*   tx:       bytes to send or NULL (SPI_FILL is sent)
+*   rx:       destination of the received bytes or NULL
+*   length:   number of bytes (at least 1)
+*   callback: called when done, or NULL
+*
+*   returns: true (started) or false (another transfer is running or length is 0)
+*
+***************************************************************************************************
+*/
+bool SPI_transfer_async(const SPI_device *device, const unsigned char *tx, unsigned char *rx, unsigned int length,
+                        void (*callback)(const SPI_device *device))
+{
+    if (SPI_busy() || (length == 0)) {
+        return false;
+    }
+    
+    SPI_select(device);
+    
+    SPI_async_tx_step = tx ? 1 : 0;
+    SPI_async_tx = tx ? tx : &SPI_fill;
+    SPI_async_rx_step = rx ? 1 : 0;
+    SPI_async_rx = rx ? rx : &SPI_discard;
+    SPI_async_length = length;
+    SPI_async_callback = callback;
+    SPI_async_device = device;
+    
+    SPCR |= (1<<SPIE);
+    SPDR = *SPI_async_tx;                               /* The ISR sends the rest */
+    SPI_async_tx += SPI_async_tx_step;
+    
+    return true;
+}
+
+/*
+***************************************************************************************************
+* Function: SPI_busy
+* ------------------
+*   returns: true while an asynchronous transfer is running
+*
+***************************************************************************************************
+*/
+bool SPI_busy(void)
+{
+    return SPI_async_device != 0;
+}
+
+/*
+***************************************************************************************************
+* Interrupt vector for SPI Serial Transfer Complete
+* -------------------------------------------------
+*   Next byte first (keeps the gap short), then store the received one. After the last byte
+*   the device is released and the callback is called.
+*
+***************************************************************************************************
+*/
+ISR (SPI_vect)
+{
+    const SPI_device *device = SPI_async_device;
+    unsigned char     next;
+    unsigned char     received;
+    
+    
+    if (--SPI_async_length) {
+        next = *SPI_async_tx;
+        SPDR = next;
+        received = SPDR;                                /* Previous byte, still readable */
+        SPI_async_tx += SPI_async_tx_step;
+        *SPI_async_rx = received;
+        SPI_async_rx += SPI_async_rx_step;
+        return;
+    }
+    
+    *SPI_async_rx = SPDR;
+    SPCR &= ~(1<<SPIE);
+    SPI_deselect(device);
+    SPI_async_device = 0;
+    
+    if (SPI_async_callback) {
+        SPI_async_callback(device);
+    }
+}
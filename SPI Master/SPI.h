@@ -0,0 +1,119 @@
+/*
+***************************************************************************************************
+* Project:  SPI Master
+* Filename: SPI.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for SPI.c
+*
+***************************************************************************************************
+*/
+
+
+#ifndef SPI_H_
+#define SPI_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define F_CPU   8000000UL           /* F_osc=8MHz & CKDIV=1 -> 8MHz / 1 = 8MHz */
+
+#define SPI_FILL                0xFF            /* Sent when there is no transmit data            */
+
+/* SPI pins (REMAP SPIMAP = 0) */
+#define SPI_DDR                 DDRA
+#define SPI_SCK                 4               /* PA4 */
+#define SPI_MISO                5               /* PA5 */
+#define SPI_MOSI                6               /* PA6 */
+#define SPI_SS                  7               /* PA7, output: as input a low level would make   */
+                                                /* the SPI a slave                                */
+
+/* End of configuration options. Change followings only if you know what you are doing.          */
+/* ********************************************************************************************* */
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+/* SPI modes: clock polarity and phase */
+#define SPI_MODE0               0               /* CPOL 0, CPHA 0: sample on rising edge  */
+#define SPI_MODE1               1               /* CPOL 0, CPHA 1: sample on falling edge */
+#define SPI_MODE2               2               /* CPOL 1, CPHA 0: sample on falling edge */
+#define SPI_MODE3               3               /* CPOL 1, CPHA 1: sample on rising edge  */
+
+#define SPI_MSB_FIRST           0
+#define SPI_LSB_FIRST           1
+
+/* Clock divider F_CPU / divider -> SPR1..0 and SPI2X */
+#define SPI_DIVIDER_OK(divider) (((divider) == 2) || ((divider) == 4) || ((divider) == 8) || ((divider) == 16) ||   \
+                                 ((divider) == 32) || ((divider) == 64) || ((divider) == 128))
+#define SPI_SPR(divider)        ((((divider) == 2) || ((divider) == 4)) ? 0 :                     \
+                                 (((divider) == 8) || ((divider) == 16)) ? 1 :                    \
+                                 (((divider) == 32) || ((divider) == 64)) ? 2 : 3)
+#define SPI_2X(divider)         (((divider) == 2) || ((divider) == 8) || ((divider) == 32))
+
+#define SPI_SPCR(mode, order, divider)  ((1<<SPE)|(1<<MSTR)|((order)<<DORD)|((mode)<<CPHA)|SPI_SPR(divider))
+
+/* Declare a device. The divider is checked at compile time.
+ *
+ *   name:    name of the SPI_device
+ *   port:    PORTx of the chip select (active low)
+ *   ddr:     DDRx of the chip select
+ *   bit:     bit of the chip select
+ *   mode:    SPI_MODE0...SPI_MODE3
+ *   order:   SPI_MSB_FIRST or SPI_LSB_FIRST
+ *   divider: SCK = F_CPU / divider (2, 4, 8, 16, 32, 64 or 128)
+ */
+#define SPI_DEVICE(name, port, ddr, bit, mode, order, divider)                                    \
+    const SPI_device name = {                                                                     \
+        &(port), &(ddr), (1 << (bit)), SPI_SPCR(mode, order, divider),                            \
+        SPI_2X(divider) + 0 * sizeof(char[SPI_DIVIDER_OK(divider) ? 1 : -1])                      \
+    }
+
+/* Device descriptor, use SPI_DEVICE */
+typedef struct {
+    volatile unsigned char *cs_port;        /* Chip select PORTx        */
+    volatile unsigned char *cs_ddr;         /* Chip select DDRx         */
+    unsigned char           cs_mask;        /* Chip select bit mask     */
+    unsigned char           spcr;           /* SPCR: mode, order, SPR   */
+    unsigned char           spi2x;          /* SPSR: double speed       */
+} SPI_device;
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdbool.h>
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+void SPI_init(void);
+void SPI_disable(void);
+void SPI_device_init(const SPI_device *device);
+void SPI_select(const SPI_device *device);
+void SPI_deselect(const SPI_device *device);
+unsigned char SPI_exchange_byte(unsigned char byte);
+void SPI_exchange(const unsigned char *tx, unsigned char *rx, unsigned int length);
+void SPI_transfer(const SPI_device *device, const unsigned char *tx, unsigned char *rx, unsigned int length);
+bool SPI_transfer_async(const SPI_device *device, const unsigned char *tx, unsigned char *rx, unsigned int length,
+                        void (*callback)(const SPI_device *device));
+bool SPI_busy(void);
+
+
+
+#endif /* SPI_H_ */
@@ -0,0 +1,167 @@
+/*
+***************************************************************************************************
+* Project:  SPI Master
+* Filename: main.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a test program for the SPI Master Driver.
+*              Flash (JEDEC commands) on PB0 at F_CPU/2 with polled transfers, radio on PB1 at
+*              F_CPU/64 with interrupt-driven transfers.
+*              Have a look at the tasks for an example. Uses Tick.c and Scheduler.c of the
+*              Scheduler project (add them and ../Scheduler to the include paths).
+*
+***************************************************************************************************
+*/
+
+#include "main.h"
+#include "SPI.h"
+#include "Scheduler.h"
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+static unsigned char flash_job(SCHEDULER_task *task);
+static unsigned char radio_task(SCHEDULER_task *task);
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+SPI_DEVICE(flash, PORTB, DDRB, 0, SPI_MODE0, SPI_MSB_FIRST, 2);
+SPI_DEVICE(radio, PORTB, DDRB, 1, SPI_MODE0, SPI_MSB_FIRST, 64);
+
+SCHEDULER_TASK(flash_reader, flash_job, 10);    /* Every 10ms */
+SCHEDULER_TASK(radio_sender, radio_task, 0);    /* Runs forever */
+
+static const unsigned char jedec_id_command[1] = { 0x9F };
+
+static unsigned char jedec_id[3];               /* for debugging */
+static unsigned char page[64];                  /* for debugging */
+static unsigned char payload[32];               /* for debugging */
+
+
+/*
+***************************************************************************************************
+**                                             MAIN
+***************************************************************************************************
+*/
+int main(void)
+{
+    /* Local variables */
+    unsigned char i;
+    
+    /* Initializations */
+    ATtiny841_board_init();
+    SPI_init();
+    SPI_device_init(&flash);
+    SPI_device_init(&radio);
+    TICK_init();
+    
+    for (i = 0; i < sizeof(payload); ++i) {
+        payload[i] = i;
+    }
+    
+    SCHEDULER_add(&flash_reader);
+    SCHEDULER_add(&radio_sender);
+    
+    
+    /* Main loop */
+    SCHEDULER_run();                            /* Sleeps between the tasks, does not return */
+    
+} /* Main */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: flash_job
+* -------------------
+*   Periodic job: read the JEDEC ID and the first 64 bytes of the flash with polled transfers.
+*   Waits while the radio transfer uses the SPI.
+*
+***************************************************************************************************
+*/
+static unsigned char flash_job(SCHEDULER_task *task)
+{
+    TASK_BEGIN(task);
+    
+    TASK_WAIT_UNTIL(task, !SPI_busy());
+    
+    /* Command in parts: opcode, then the answer */
+    SPI_select(&flash);
+    SPI_exchange(jedec_id_command, 0, 1);
+    SPI_exchange(0, jedec_id, sizeof(jedec_id));         /* for debugging, manufacturer, type, capacity */
+    SPI_deselect(&flash);
+    
+    /* Read 64 bytes from address 0 back-to-back at F_CPU/2 */
+    SPI_select(&flash);
+    SPI_exchange_byte(0x03);                             /* Read Data */
+    SPI_exchange_byte(0x00);
+    SPI_exchange_byte(0x00);
+    SPI_exchange_byte(0x00);
+    SPI_exchange(0, page, sizeof(page));
+    SPI_deselect(&flash);
+    
+    TASK_END(task);
+}
+
+/*
+***************************************************************************************************
+* Function: radio_task
+* --------------------
+*   Task: send the payload to the slow device every 10ms. The ISR sends it, the other tasks
+*   run meanwhile.
+*
+***************************************************************************************************
+*/
+static unsigned char radio_task(SCHEDULER_task *task)
+{
+    TASK_BEGIN(task);
+    
+    while(1)
+    {
+        TASK_WAIT_UNTIL(task, SPI_transfer_async(&radio, payload, 0, sizeof(payload), 0));    /* Starts when the SPI is free */
+        TASK_WAIT_UNTIL(task, !SPI_busy());
+        TASK_DELAY(task, 10);
+    }
+    
+    TASK_END(task);
+}
+
+/*
+***************************************************************************************************
+* Function: ATtiny841_board_init
+* ------------------------------
+*   Initializes the ports of the ATtiny841-board
+*   PA5 (MISO) is an input, the chip selects are set up by SPI_device_init
+*   All peripherals are turned off, the drivers turn on what they use
+*
+***************************************************************************************************
+*/
+void ATtiny841_board_init(void)
+{
+    /* 0 -> input | 1 -> output */
+            
+    /* Bit:  76543210 */
+    DDRA = 0b11011111;
+    DDRB = 0b11111111;
+            
+    PORTA = 0b00000000;
+    PORTB = 0b00000011;                 /* Chip selects high */
+    
+    PRR = (1<<PRTWI)|(1<<PRUSART1)|(1<<PRUSART0)|(1<<PRSPI)|(1<<PRTIM2)|(1<<PRTIM1)|(1<<PRTIM0)|(1<<PRADC);
+    ACSR0A = (1<<ACD0);                 /* Analog comparators off */
+    ACSR1A = (1<<ACD1);
+}
@@ -0,0 +1,169 @@
+/*
+***************************************************************************************************
+* Project:  Scheduler
+* Filename: Host/scheduler_test.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Runs the scheduler on the host with a simulated millisecond tick (Tick.c is not
+*              built, the test counts TICK_count itself, 16 bit like on the AVR). The tick runs past
+*              0x8000 and 0xFFFF while tasks wait, every check prints its result. Exit code 1 if a
+*              check failed.
+*
+*              make && ./scheduler_test
+*
+***************************************************************************************************
+*/
+
+#include <stdio.h>
+
+#include "Scheduler.h"
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+static unsigned char wait_task(SCHEDULER_task *task);
+static unsigned char yield_task(SCHEDULER_task *task);
+static unsigned char delay_task(SCHEDULER_task *task);
+static unsigned char periodic_job(SCHEDULER_task *task);
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+volatile unsigned int TICK_count = 0;               /* Of Tick.c */
+
+SCHEDULER_TASK(waiter, wait_task, 0);
+SCHEDULER_TASK(yielder, yield_task, 0);
+SCHEDULER_TASK(sleeper, delay_task, 0);
+SCHEDULER_TASK(periodic, periodic_job, 100);
+
+static bool          event = false;                 /* Condition of wait_task */
+static unsigned long event_seen = 0;                /* Tick of the last reaction of wait_task */
+static unsigned long yields = 0;                    /* Runs of yield_task */
+static unsigned long delays = 0;                    /* Ended delays of delay_task */
+static unsigned long jobs = 0;                      /* Runs of periodic_job */
+static unsigned long ticks = 0;                     /* Ticks since the start, does not wrap */
+static int           failed = 0;
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+static void check(const char *name, bool ok)
+{
+    printf("%-52s %s\n", name, ok ? "ok" : "FAIL");
+    if (!ok) {
+        failed = 1;
+    }
+}
+
+/* Task: waits for event, the condition is checked at every run */
+static unsigned char wait_task(SCHEDULER_task *task)
+{
+    TASK_BEGIN(task);
+    
+    while(1)
+    {
+        TASK_WAIT_UNTIL(task, event);
+        event = false;
+        event_seen = ticks;
+    }
+    
+    TASK_END(task);
+}
+
+/* Task: gives the CPU away at every run */
+static unsigned char yield_task(SCHEDULER_task *task)
+{
+    TASK_BEGIN(task);
+    
+    while(1)
+    {
+        yields++;
+        TASK_YIELD(task);
+    }
+    
+    TASK_END(task);
+}
+
+/* Task: 1s delays */
+static unsigned char delay_task(SCHEDULER_task *task)
+{
+    TASK_BEGIN(task);
+    
+    while(1)
+    {
+        TASK_DELAY(task, 1000);
+        delays++;
+    }
+    
+    TASK_END(task);
+}
+
+/* Periodic job: every 100ms */
+static unsigned char periodic_job(SCHEDULER_task *task)
+{
+    TASK_BEGIN(task);
+    
+    jobs++;
+    
+    TASK_END(task);
+}
+
+/* ms milliseconds: one tick and one run of the scheduler per millisecond */
+static void run(unsigned long ms)
+{
+    while (ms--) {
+        TICK_count = (TICK_count + 1) & 0xFFFF;     /* 16 bit like on the AVR */
+        ticks++;
+        SCHEDULER_run_once();
+    }
+}
+
+/* Raise event at the current tick, true if wait_task reacted in the same run */
+static bool event_now(void)
+{
+    event = true;
+    run(1);
+    return !event && (event_seen == ticks);
+}
+
+
+/*
+***************************************************************************************************
+**                                             MAIN
+***************************************************************************************************
+*/
+int main(void)
+{
+    SCHEDULER_add(&waiter);
+    SCHEDULER_add(&yielder);
+    SCHEDULER_add(&sleeper);
+    SCHEDULER_add(&periodic);
+    SCHEDULER_run_once();                           /* Tick 0 */
+    
+    check("TASK_WAIT_UNTIL reacts at the start", event_now());
+    
+    run(0x8000 + 100 - TICK_count);                 /* Waiting since tick 1 */
+    check("TASK_WAIT_UNTIL reacts 32.8s after its last run", event_now());
+    check("TASK_YIELD runs at every tick past 0x8000", yields == ticks + 1);
+    
+    run(0x10000 + 0x8000 + 100 - ticks);            /* Tick wraps, waits again for 32.8s */
+    check("TASK_WAIT_UNTIL reacts after the tick wrapped", event_now());
+    check("TASK_YIELD runs at every tick after the wrap", yields == ticks + 1);
+    check("TASK_DELAY(1000) ends once per second", delays == ticks / 1000);
+    check("periodic job runs every 100ms", (jobs == ticks / 100 + 1) && (periodic.late == 0));
+    
+    printf("%lu ticks\n", ticks);
+    
+    return failed;
+}
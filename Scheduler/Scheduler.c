@@ -0,0 +1,161 @@
+/*
+***************************************************************************************************
+* Project:  Scheduler
+* Filename: Scheduler.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Cooperative scheduler for protothread tasks and periodic jobs.
+*              SCHEDULER_run goes through the list of tasks and runs every task whose wake time
+*              has come, then sleeps in Idle until the next interrupt. The millisecond tick
+*              wakes it at least once per millisecond, so a waiting condition is checked within
+*              1ms and a delay ends within 1ms.
+*
+*              No task has a stack of its own: a task takes 13 bytes of SRAM. A task that does
+*              not come back (e.g. waits in a loop) blocks all the others.
+*
+***************************************************************************************************
+*/
+
+#include "Scheduler.h"
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static SCHEDULER_task *SCHEDULER_tasks = 0;     /* First task of the list */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: SCHEDULER_add
+* -----------------------
+*   Start a task: it runs from TASK_BEGIN at the next run of the scheduler, a periodic job
+*   counts its periods from now. A task that is already in the list is started again.
+*   May be called by a task.
+*
+*   task: task declared with SCHEDULER_TASK
+*
+***************************************************************************************************
+*/
+void SCHEDULER_add(SCHEDULER_task *task)
+{
+    SCHEDULER_task **link = &SCHEDULER_tasks;
+    
+    
+    task->line = 0;
+    task->wake = TICK_now();
+    task->release = task->wake;
+    task->late = 0;
+    
+    while ((*link != 0) && (*link != task)) {          /* New tasks go to the end of the list */
+        link = &(*link)->next;
+    }
+    if (*link == 0) {
+        task->next = 0;
+        *link = task;
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: SCHEDULER_remove
+* --------------------------
+*   Stop a task. May be called by a task, also for itself (then it returns with TASK_WAITING).
+*
+*   task: task to remove
+*
+***************************************************************************************************
+*/
+void SCHEDULER_remove(SCHEDULER_task *task)
+{
+    SCHEDULER_task **link = &SCHEDULER_tasks;
+    
+    
+    while (*link != 0) {
+        if (*link == task) {
+            *link = task->next;                         /* task->next stays, a running pass goes on */
+            return;
+        }
+        link = &(*link)->next;
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: SCHEDULER_run_once
+* ----------------------------
+*   Run every task whose wake time has come, once. For a main loop that has other work or its
+*   own sleep, otherwise use SCHEDULER_run.
+*
+***************************************************************************************************
+*/
+void SCHEDULER_run_once(void)
+{
+    SCHEDULER_task **link = &SCHEDULER_tasks;
+    SCHEDULER_task  *task;
+    unsigned int     now = TICK_now();
+    unsigned int     next;
+    
+    
+    while ((task = *link) != 0) {
+        if (TICK_reached(now, task->wake)) {
+            task->wake = now;                           /* A waiting task stays due after 32.7s too */
+            if (task->function(task) == TASK_ENDED) {
+                if (task->period == 0) {
+                    *link = task->next;                 /* Done */
+                    continue;
+                }
+    
+                next = task->release + task->period;
+                now = TICK_now();
+                if (!TICK_reached(next, now)) {         /* Ended after the next start: too late */
+                    if (task->late != 0xFF) {
+                        task->late++;
+                    }
+                    next = now;
+                }
+                task->release = next;
+                task->wake = next;
+            }
+        }
+    
+        if (*link == task) {                            /* Not removed by itself */
+            link = &task->next;
+        }
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: SCHEDULER_run
+* -----------------------
+*   Run the tasks forever, with SCHEDULER_SLEEP 1 the CPU is in Idle between the runs.
+*   TICK_init must have been called.
+*
+***************************************************************************************************
+*/
+void SCHEDULER_run(void)
+{
+#if SCHEDULER_SLEEP
+    set_sleep_mode(SLEEP_MODE_IDLE);
+#endif
+    
+    while(1)
+    {
+        SCHEDULER_run_once();
+    
+#if SCHEDULER_SLEEP
+        sleep_mode();                                   /* Until the next tick or interrupt */
+#endif
+    }
+}
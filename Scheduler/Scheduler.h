@@ -0,0 +1,141 @@
+/*
+***************************************************************************************************
+* Project:  Scheduler
+* Filename: Scheduler.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for Scheduler.c
+*
+*              A task is a function with TASK_BEGIN at the start and TASK_END at the end. In
+*              between it gives the CPU to the other tasks with TASK_YIELD, TASK_WAIT_UNTIL and
+*              TASK_DELAY and goes on after that point the next time it runs (protothread).
+*              The tasks share one stack, so local variables are lost at these points: use
+*              static variables for values that must survive. A TASK_ macro must not be used
+*              inside a switch statement of the task.
+*
+*              unsigned char blink(SCHEDULER_task *task)
+*              {
+*                  TASK_BEGIN(task);
+*                  TASK_WAIT_UNTIL(task, button_pressed());
+*                  PORTB ^= (1<<PB0);
+*                  TASK_DELAY(task, 20);
+*                  TASK_END(task);
+*              }
+*
+***************************************************************************************************
+*/
+
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define SCHEDULER_SLEEP         1       /* 1 -> Idle between the runs, woken by the tick or any   */
+                                        /*      other interrupt, 0 -> runs the tasks all the time */
+
+/* End of configuration options. Change followings only if you know what you are doing.          */
+/* ********************************************************************************************* */
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+/* Return values of a task */
+#define TASK_WAITING            0       /* Goes on at the last TASK_ macro                    */
+#define TASK_ENDED              1       /* Starts again after the period or is removed (0ms)  */
+
+/* Resume point of a task: the line of the TASK_ macro, 0 -> start */
+#define TASK_BEGIN(task)        switch ((task)->line) { case 0:
+    
+#define TASK_END(task)          } (task)->line = 0; return TASK_ENDED
+
+/* Let the other tasks run, go on with the next run */
+#define TASK_YIELD(task)        do {                                                            \
+                                    (task)->line = __LINE__;                                    \
+                                    return TASK_WAITING;                                        \
+                                    case __LINE__: ;                                            \
+                                } while (0)
+
+/* Check the condition at every run (every tick or interrupt), go on as soon as it is true */
+#define TASK_WAIT_UNTIL(task, condition)                                                        \
+                                do {                                                            \
+                                    (task)->line = __LINE__;                                    \
+                                    case __LINE__:                                              \
+                                    if (!(condition)) {                                         \
+                                        return TASK_WAITING;                                    \
+                                    }                                                           \
+                                } while (0)
+
+/* Go on after ms milliseconds (1...32767), the task is not run meanwhile */
+#define TASK_DELAY(task, ms)    do {                                                            \
+                                    (task)->wake = TICK_now() + (ms);                           \
+                                    TASK_YIELD(task);                                           \
+                                } while (0)
+
+/* End the task here, like TASK_END */
+#define TASK_EXIT(task)         do {                                                            \
+                                    (task)->line = 0;                                           \
+                                    return TASK_ENDED;                                          \
+                                } while (0)
+
+/* Declare a task. The period is checked at compile time.
+ *
+ *   name:     name of the SCHEDULER_task
+ *   function: unsigned char function(SCHEDULER_task *task)
+ *   period:   0 -> the task runs once (is removed after TASK_END)
+ *             1...32767 -> periodic job: starts again period ms after its last start. If it
+ *             ends after the next start was due, the deadline is missed: late counts up and the
+ *             job starts again at once.
+ */
+#define SCHEDULER_TASK(name, function, period)                                                    \
+    SCHEDULER_task name = {                                                                       \
+        (function), (period) + 0 * sizeof(char[((period) >= 0) && ((period) <= 32767) ? 1 : -1]), \
+        0, 0, 0, 0, 0                                                                             \
+    }
+
+/* Task descriptor, use SCHEDULER_TASK */
+typedef struct SCHEDULER_task {
+    unsigned char         (*function)(struct SCHEDULER_task *task);
+    unsigned int            period;     /* ms, 0 -> once                                    */
+    unsigned int            line;       /* Resume point                                     */
+    unsigned int            wake;       /* Tick of the next run                             */
+    unsigned int            release;    /* Tick of the current period                       */
+    unsigned char           late;       /* Missed deadlines, stops at 255                   */
+    struct SCHEDULER_task  *next;       /* List of the scheduled tasks                      */
+} SCHEDULER_task;
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stdbool.h>
+#include "Tick.h"
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+void SCHEDULER_add(SCHEDULER_task *task);
+void SCHEDULER_remove(SCHEDULER_task *task);
+void SCHEDULER_run_once(void);
+void SCHEDULER_run(void);
+
+
+
+#endif /* SCHEDULER_H_ */
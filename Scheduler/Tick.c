@@ -0,0 +1,87 @@
+/*
+***************************************************************************************************
+* Project:  Scheduler
+* Filename: Tick.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Millisecond system tick with Timer0 (8 bit, CTC mode).
+*              Timer0 keeps running in Idle but not in Power-down, so the CPU must not go to
+*              Power-down while the tick is used. Timer1 and Timer2 stay free for the drivers
+*              (I2C_Async, Profile).
+*
+***************************************************************************************************
+*/
+
+#include "Tick.h"
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+volatile unsigned int TICK_count = 0;
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: TICK_start
+* --------------------
+*   Power on Timer0 (PRR) and start the tick. Use TICK_init, it calculates the arguments from
+*   F_CPU.
+*
+*   clock_select: CS02..0 of the prescaler
+*   top:          OCR0A, timer clocks per millisecond - 1
+*
+***************************************************************************************************
+*/
+void TICK_start(unsigned char clock_select, unsigned char top)
+{
+    PRR &= ~(1<<PRTIM0);
+    
+    TCCR0B = 0;
+    TCNT0 = 0;
+    TCCR0A = (1<<WGM01);                                /* CTC, TOP = OCR0A */
+    OCR0A = top;
+    TIFR0 = (1<<OCF0A);
+    TIMSK0 = (1<<OCIE0A);
+    TCCR0B = clock_select;
+    
+    sei();
+}
+
+/*
+***************************************************************************************************
+* Function: TICK_stop
+* -------------------
+*   Stop the tick and turn Timer0 off (also in PRR). TICK_count keeps its value.
+*
+***************************************************************************************************
+*/
+void TICK_stop(void)
+{
+    TCCR0B = 0;
+    TIMSK0 = 0;
+    PRR |= (1<<PRTIM0);
+}
+
+/*
+***************************************************************************************************
+* Interrupt vector for Timer0 Compare Match A
+* -------------------------------------------
+*   One millisecond has passed.
+*
+***************************************************************************************************
+*/
+ISR (TIMER0_COMPA_vect)
+{
+    TICK_count++;
+}
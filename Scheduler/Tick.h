@@ -0,0 +1,111 @@
+/*
+***************************************************************************************************
+* Project:  Scheduler
+* Filename: Tick.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for Tick.c
+*
+*              The projects use different clocks, so F_CPU is not defined here. TICK_init is a
+*              macro that sets up the timer for the F_CPU of the file that calls it (include
+*              main.h first).
+*
+***************************************************************************************************
+*/
+
+
+#ifndef TICK_H_
+#define TICK_H_
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+/* Timer0 in CTC mode, one compare match A per millisecond. Smallest prescaler with TOP <= 255. */
+#ifdef F_CPU
+#if (F_CPU / 1000UL) <= 256UL
+#define TICK_PRESCALER          1UL
+#define TICK_CS                 1
+#elif (F_CPU / 1000UL) <= 2048UL
+#define TICK_PRESCALER          8UL
+#define TICK_CS                 2
+#elif (F_CPU / 1000UL) <= 16384UL
+#define TICK_PRESCALER          64UL
+#define TICK_CS                 3
+#else
+#define TICK_PRESCALER          256UL
+#define TICK_CS                 4
+#endif
+
+#define TICK_TOP                (F_CPU / (1000UL * TICK_PRESCALER) - 1)
+
+#if (F_CPU % (1000UL * TICK_PRESCALER)) != 0
+#warning "F_CPU is not a multiple of 1000 * TICK_PRESCALER, the tick is not exactly 1ms"
+#endif
+
+#define TICK_init()             TICK_start(TICK_CS, TICK_TOP)
+#endif /* F_CPU */
+
+/* ADC.h (included before) checks this for the other order */
+#if defined(ADC_H_) && (ADC_TRIGGER == ADC_TRIGGER_TIMER0)
+#error "ADC_TRIGGER_TIMER0 of ADC.h and the tick both use Timer0, use ADC_TRIGGER_FREE_RUNNING"
+#endif
+
+/* true when the tick has reached time (up to 32767ms ahead of it), 16 bit like the tick */
+#define TICK_reached(now, time) ((int16_t)((uint16_t)(now) - (uint16_t)(time)) >= 0)
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+extern volatile unsigned int TICK_count;       /* Milliseconds since TICK_init, wraps after 65.5s */
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+void TICK_start(unsigned char clock_select, unsigned char top);
+void TICK_stop(void);
+
+/*
+***************************************************************************************************
+* Function: TICK_now
+* ------------------
+*   returns: milliseconds since TICK_init (wraps after 65.5s, compare with TICK_reached)
+*
+***************************************************************************************************
+*/
+static inline unsigned int TICK_now(void)
+{
+    unsigned int now = 0;
+    
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        now = TICK_count;
+    }
+    return now;
+}
+
+
+
+#endif /* TICK_H_ */
@@ -0,0 +1,137 @@
+/*
+***************************************************************************************************
+* Project:  Scheduler
+* Filename: main.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a test program for the Scheduler.
+*              LED on PB0 blinks with a periodic job, a task debounces the button on PA0 and
+*              toggles the LED on PB1. The CPU sleeps in Idle in between.
+*              Have a look at the tasks for an example.
+*
+*              Other projects use the scheduler by adding Tick.c and Scheduler.c to the project
+*              and this directory to the include paths.
+*
+***************************************************************************************************
+*/
+
+#include "main.h"
+#include "Scheduler.h"
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+static unsigned char blink_job(SCHEDULER_task *task);
+static unsigned char button_task(SCHEDULER_task *task);
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+SCHEDULER_TASK(blink, blink_job, 500);          /* Every 500ms */
+SCHEDULER_TASK(button, button_task, 0);         /* Runs forever */
+
+
+/*
+***************************************************************************************************
+**                                             MAIN
+***************************************************************************************************
+*/
+int main(void)
+{
+    /* Initializations */
+    ATtiny841_board_init();
+    TICK_init();
+    
+    SCHEDULER_add(&blink);
+    SCHEDULER_add(&button);
+    
+    
+    /* Main loop */
+    SCHEDULER_run();                            /* Does not return */
+    
+} /* Main */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: blink_job
+* -------------------
+*   Periodic job: toggle PB0. blink.late counts up if it could not start on time.
+*
+***************************************************************************************************
+*/
+static unsigned char blink_job(SCHEDULER_task *task)
+{
+    TASK_BEGIN(task);
+    
+    PORTB ^= (1<<PB0);
+    
+    TASK_END(task);
+}
+
+/*
+***************************************************************************************************
+* Function: button_task
+* ---------------------
+*   Task: toggle PB1 when the button on PA0 (to GND) is pressed. The bouncing is skipped with
+*   a delay, the other tasks run meanwhile.
+*
+***************************************************************************************************
+*/
+static unsigned char button_task(SCHEDULER_task *task)
+{
+    TASK_BEGIN(task);
+    
+    while(1)
+    {
+        TASK_WAIT_UNTIL(task, !(PINA & (1<<PA0)));
+        PORTB ^= (1<<PB1);
+        TASK_DELAY(task, 20);
+        
+        TASK_WAIT_UNTIL(task, PINA & (1<<PA0));
+        TASK_DELAY(task, 20);
+    }
+    
+    TASK_END(task);
+}
+
+/*
+***************************************************************************************************
+* Function: ATtiny841_board_init
+* ------------------------------
+*   Initializes the ports of the ATtiny841-board
+*   PA0 is an input with pull-up for the button
+*   All peripherals are turned off, the drivers turn on what they use
+*
+***************************************************************************************************
+*/
+void ATtiny841_board_init(void)
+{
+    /* 0 -> input | 1 -> output */
+            
+    /* Bit:  76543210 */
+    DDRA = 0b11111110;
+    DDRB = 0b11111111;
+            
+    PORTA = 0b00000000;
+    PORTB = 0b00000000;
+    PUEA  = 0b00000001;                 /* Pull-up of the button (PUEx, not PORTx on the ATtiny841) */
+    
+    PRR = (1<<PRTWI)|(1<<PRUSART1)|(1<<PRUSART0)|(1<<PRSPI)|(1<<PRTIM2)|(1<<PRTIM1)|(1<<PRTIM0)|(1<<PRADC);
+    ACSR0A = (1<<ACD0);                 /* Analog comparators off */
+    ACSR1A = (1<<ACD1);
+}
@@ -0,0 +1,264 @@
+/*
+***************************************************************************************************
+* Project:  TWI Slave
+* Filename: TWI_Slave.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is an interrupt driven driver for the TWI slave of the ATtiny841.
+*              The slave exposes a register map to the I2C master. Like most I2C devices the
+*              first byte of a write sets the register pointer, it increments after every byte.
+*
+*              Read registers (slave -> master) are double-buffered: the application fills the
+*              back bank (TWI_slave_edit) and swaps it with TWI_slave_publish. A swap never
+*              happens during a read transaction, so the master always gets a consistent set of
+*              multi-byte values and the ISR never has to copy (no clock stretching).
+*
+*              Bytes written by the master go to a separate write map. TWI_slave_received
+*              reports them after the STOP condition.
+*
+*              A bus error or collision ends the transaction like a STOP, an unfinished write
+*              is dropped. A read without STOP ends with the next START.
+*
+***************************************************************************************************
+*/
+
+#include "TWI_Slave.h"
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static unsigned char          TWI_slave_bank[2][TWI_SLAVE_REGISTERS];
+static volatile unsigned char TWI_slave_front = 0;          /* Bank the master reads from */
+static volatile bool          TWI_slave_reading = false;    /* Read transaction running */
+static volatile bool          TWI_slave_pending = false;    /* Swap banks at the end of the read */
+static bool                   TWI_slave_copy = false;       /* Back bank has to be updated */
+
+static volatile unsigned char TWI_slave_writes[TWI_SLAVE_REGISTERS];
+static volatile unsigned char TWI_slave_write_first;        /* First register of the last write */
+static volatile unsigned char TWI_slave_write_count;        /* Bytes of the last write */
+static volatile bool          TWI_slave_write_done = false;
+
+static volatile unsigned char TWI_slave_pointer = 0;        /* Register pointer */
+static volatile bool          TWI_slave_first_byte;         /* Next written byte is the pointer */
+                                                            /* or next read byte is the first one */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: TWI_slave_init
+* ------------------------
+*   Initializes the TWI slave with TWI_SLAVE_ADDRESS. All registers are 0.
+*
+***************************************************************************************************
+*/
+void TWI_slave_init(void)
+{
+    PRR   &= ~(1<<PRTWI);                                       /* Power on */
+    TWSA   = (TWI_SLAVE_ADDRESS << 1);
+    TWSAM  = 0;                                                 /* No address mask */
+    TWSCRA = (1<<TWDIE)|(1<<TWASIE)|(1<<TWEN)|(1<<TWSIE);       /* Data, address and stop interrupt, enable */
+    
+    sei();
+}
+
+/*
+***************************************************************************************************
+* Function: TWI_slave_edit
+* ------------------------
+*   Get the back bank of the read registers. Change the registers there and call
+*   TWI_slave_publish to make them visible to the master. Does not wait: while a swap is
+*   pending the master still reads the back bank, try again later.
+*
+*   returns: pointer to TWI_SLAVE_REGISTERS bytes or 0 (swap pending)
+*
+***************************************************************************************************
+*/
+unsigned char *TWI_slave_edit(void)
+{
+    unsigned char back;
+    
+    
+    if (TWI_slave_pending) {                                    /* Back bank is still in use */
+        return 0;
+    }
+    
+    back = TWI_slave_front ^ 1;
+    
+    if (TWI_slave_copy) {                                       /* Start from the published values */
+        memcpy(TWI_slave_bank[back], TWI_slave_bank[back ^ 1], TWI_SLAVE_REGISTERS);
+        TWI_slave_copy = false;
+    }
+    
+    return TWI_slave_bank[back];
+}
+
+/*
+***************************************************************************************************
+* Function: TWI_slave_end_read
+* ----------------------------
+*   End a read transaction of the master, do the pending swap. Called by the ISR.
+*
+***************************************************************************************************
+*/
+static void TWI_slave_end_read(void)
+{
+    TWI_slave_reading = false;
+    if (TWI_slave_pending) {
+        TWI_slave_front ^= 1;
+        TWI_slave_pending = false;
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: TWI_slave_publish
+* ---------------------------
+*   Make the back bank visible to the master. If the master is reading right now, the swap
+*   is done by the ISR at the end of the transaction.
+*
+***************************************************************************************************
+*/
+void TWI_slave_publish(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (TWI_slave_reading) {
+            TWI_slave_pending = true;
+        } else {
+            TWI_slave_front ^= 1;
+        }
+    }
+    TWI_slave_copy = true;
+}
+
+/*
+***************************************************************************************************
+* Function: TWI_slave_received
+* ----------------------------
+*   Check for a completed write of the master. The data is in TWI_slave_write_map, it stays
+*   valid until the next write of the master.
+*
+*   first_register: first register that was written
+*   count:          number of bytes written
+*
+*   returns: true (new data, reported only once) or false (nothing new)
+*
+***************************************************************************************************
+*/
+bool TWI_slave_received(unsigned char *first_register, unsigned char *count)
+{
+    bool done = false;
+    
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (TWI_slave_write_done) {
+            *first_register = TWI_slave_write_first;
+            *count = TWI_slave_write_count;
+            TWI_slave_write_done = false;
+            done = true;
+        }
+    }
+    return done;
+}
+
+/*
+***************************************************************************************************
+* Function: TWI_slave_write_map
+* -----------------------------
+*   returns: the registers written by the master
+*
+***************************************************************************************************
+*/
+const volatile unsigned char *TWI_slave_write_map(void)
+{
+    return TWI_slave_writes;
+}
+
+
+/*
+***************************************************************************************************
+* Interrupt vector for TWI Slave
+* ------------------------------
+*   Address match / STOP (TWASIF) and data (TWDIF), bus error (TWBE) and collision (TWC).
+*   Every branch answers right away, so SCL is only held for the few cycles of the ISR.
+*
+***************************************************************************************************
+*/
+ISR (TWI_SLAVE_vect)
+{
+    unsigned char status = TWSSRA;
+    unsigned char pointer;
+    unsigned char byte;
+    
+    
+    if (status & ((1<<TWBE)|(1<<TWC))) {                        /* Transaction broken off */
+        TWI_slave_end_read();
+        TWI_slave_write_count = 0;                              /* Unfinished write is dropped */
+        TWSSRA = (1<<TWBE)|(1<<TWC);
+        TWSCRB = TWI_CMD_COMPLETE;                              /* Wait for the next START */
+        return;
+    }
+    
+    if (status & (1<<TWASIF)) {
+        if (status & (1<<TWAS)) {                               /* Address match */
+            TWI_slave_end_read();                               /* Previous read without STOP */
+            TWI_slave_first_byte = true;
+            
+            if (status & (1<<TWDIR)) {
+                TWI_slave_reading = true;                       /* Master reads, keep the front bank */
+            } else {
+                TWI_slave_write_count = 0;                      /* Master writes, pointer first */
+            }
+            TWSCRB = TWI_CMD_RESPONSE;                          /* ACK the address */
+        } else {                                                /* STOP condition */
+            if (TWI_slave_reading) {
+                TWI_slave_end_read();
+            } else if (TWI_slave_write_count > 0) {
+                TWI_slave_write_done = true;
+            }
+            TWSCRB = TWI_CMD_COMPLETE;
+        }
+        return;
+    }
+    
+    if (status & (1<<TWDIF)) {
+        pointer = TWI_slave_pointer;
+        
+        if (status & (1<<TWDIR)) {                              /* Master reads */
+            if ((status & (1<<TWRA)) && !TWI_slave_first_byte) {
+                TWSCRB = TWI_CMD_COMPLETE;                      /* Master sent NACK, done */
+                return;
+            }
+            TWI_slave_first_byte = false;
+            TWSD = TWI_slave_bank[TWI_slave_front][pointer];
+            TWSCRB = TWI_CMD_RESPONSE;
+        } else {                                                /* Master writes */
+            if (TWI_slave_first_byte) {
+                TWI_slave_first_byte = false;
+                byte = TWSD;
+                TWI_slave_pointer = (byte < TWI_SLAVE_REGISTERS) ? byte : 0;
+                TWI_slave_write_first = TWI_slave_pointer;
+                TWSCRB = TWI_CMD_RESPONSE;
+                return;
+            }
+            TWI_slave_writes[pointer] = TWSD;
+            TWI_slave_write_count++;
+            TWSCRB = TWI_CMD_RESPONSE;
+        }
+        
+        if (++pointer >= TWI_SLAVE_REGISTERS) {                /* Auto-increment with wrap around */
+            pointer = 0;
+        }
+        TWI_slave_pointer = pointer;
+    }
+}
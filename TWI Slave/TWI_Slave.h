@@ -0,0 +1,67 @@
+/*
+***************************************************************************************************
+* Project:  TWI Slave
+* Filename: TWI_Slave.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for TWI_Slave.c
+*
+***************************************************************************************************
+*/
+
+
+#ifndef TWI_SLAVE_H_
+#define TWI_SLAVE_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define F_CPU   8000000UL           /* F_osc=8MHz & CKDIV=1 -> 8MHz / 1 = 8MHz */
+
+#define TWI_SLAVE_ADDRESS       0x40        /* 7-bit address of this slave */
+#define TWI_SLAVE_REGISTERS     16          /* Size of the register map (1...255) */
+
+/* End of configuration options. Change followings only if you know what you are doing.          */
+/* ********************************************************************************************* */
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define TWI_CMD_COMPLETE    (1<<TWCMD1)                 /* Ack action, then wait for any START   */
+#define TWI_CMD_RESPONSE    ((1<<TWCMD1)|(1<<TWCMD0))   /* Ack action, then next byte            */
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include <stdbool.h>
+#include <string.h>
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+void TWI_slave_init(void);
+unsigned char *TWI_slave_edit(void);
+void TWI_slave_publish(void);
+bool TWI_slave_received(unsigned char *first_register, unsigned char *count);
+const volatile unsigned char *TWI_slave_write_map(void);
+
+
+
+#endif /* TWI_SLAVE_H_ */
@@ -0,0 +1,149 @@
+/*
+***************************************************************************************************
+* Project:  TWI Slave
+* Filename: main.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a test program for the TWI Slave Driver.
+*              Register 0...1: millisecond counter (16 bit, little endian), read only
+*              Write register 0: value is put out on PORTB
+*              Have a look at the tasks for an example. Uses Tick.c and Scheduler.c of the
+*              Scheduler project (add them and ../Scheduler to the include paths).
+*
+***************************************************************************************************
+*/
+
+#include "main.h"
+#include "TWI_Slave.h"
+#include "Scheduler.h"
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+static unsigned char counter_job(SCHEDULER_task *task);
+static unsigned char receive_task(SCHEDULER_task *task);
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+SCHEDULER_TASK(counter, counter_job, 1);        /* Every millisecond */
+SCHEDULER_TASK(receive, receive_task, 0);       /* Runs forever */
+
+
+/*
+***************************************************************************************************
+**                                             MAIN
+***************************************************************************************************
+*/
+int main(void)
+{
+    /* Initializations */
+    ATtiny841_board_init();
+    TWI_slave_init();
+    TICK_init();
+    
+    SCHEDULER_add(&counter);
+    SCHEDULER_add(&receive);
+    
+    
+    /* Main loop */
+    SCHEDULER_run();                            /* Sleeps between the tasks, does not return */
+    
+} /* Main */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: counter_job
+* ---------------------
+*   Periodic job: count up and publish the counter in registers 0...1.
+*
+***************************************************************************************************
+*/
+static unsigned char counter_job(SCHEDULER_task *task)
+{
+    static unsigned int counter = 0;
+    unsigned char      *registers;
+    
+    
+    TASK_BEGIN(task);
+    
+    counter++;
+    
+    registers = TWI_slave_edit();                   /* Both bytes change together for the master */
+    if (registers != 0) {                           /* Else the master is reading, next time */
+        registers[0] = (unsigned char)counter;
+        registers[1] = (unsigned char)(counter >> 8);
+        TWI_slave_publish();
+    }
+    
+    TASK_END(task);
+}
+
+/*
+***************************************************************************************************
+* Function: receive_task
+* ----------------------
+*   Task: put register 0 out on PORTB when the master has written it.
+*
+***************************************************************************************************
+*/
+static unsigned char receive_task(SCHEDULER_task *task)
+{
+    static unsigned char first;
+    static unsigned char count;
+    
+    
+    TASK_BEGIN(task);
+    
+    while(1)
+    {
+        TASK_WAIT_UNTIL(task, TWI_slave_received(&first, &count));
+        
+        if (first == 0) {
+            PORTB = TWI_slave_write_map()[0];
+        }
+    }
+    
+    TASK_END(task);
+}
+
+/*
+***************************************************************************************************
+* Function: ATtiny841_board_init
+* ------------------------------
+*   Initializes the ports of the ATtiny841-board
+*   PA4 (SCL) and PA6 (SDA) are left as inputs for the TWI slave
+*   All peripherals are turned off, the drivers turn on what they use
+*
+***************************************************************************************************
+*/
+void ATtiny841_board_init(void)
+{
+    /* 0 -> input | 1 -> output */
+            
+    /* Bit:  76543210 */
+    DDRA = 0b10101111;
+    DDRB = 0b11111111;
+            
+    PORTA = 0b00000000;
+    PORTB = 0b00000000;
+    
+    PRR = (1<<PRTWI)|(1<<PRUSART1)|(1<<PRUSART0)|(1<<PRSPI)|(1<<PRTIM2)|(1<<PRTIM1)|(1<<PRTIM0)|(1<<PRADC);
+    ACSR0A = (1<<ACD0);                 /* Analog comparators off */
+    ACSR1A = (1<<ACD1);
+}
@@ -0,0 +1,104 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: packet_tool.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Host (Linux) encoder/decoder for the packet layer in Packet.c.
+*
+*              packet_tool encode < payload.bin > frame.bin     one frame from stdin
+*              packet_tool decode < capture.bin                 one line of hex per valid frame
+*
+*              The decoder can read a raw capture of the serial line, e.g. from a Bluetooth
+*              rfcomm device. Bad frames are reported on stderr.
+*
+***************************************************************************************************
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "../Packet.h"
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+static void put_stdout(unsigned char byte)
+{
+    putchar(byte);
+}
+
+static int encode(void)
+{
+    int c;
+    
+    
+    PACKET_send_begin();
+    
+    while ((c = getchar()) != EOF) {
+        PACKET_send_byte((unsigned char)c);
+    }
+    
+    PACKET_send_end();
+    
+    return 0;
+}
+
+static int decode(void)
+{
+    int           c;
+    unsigned char i;
+    unsigned long frames = 0;
+    unsigned long errors = 0;
+    
+    
+    while ((c = getchar()) != EOF) {
+        switch (PACKET_receive_byte((unsigned char)c)) {
+        case PACKET_RX_COMPLETE:
+            for (i = 0; i < PACKET_rx_length; i++) {
+                printf("%02X", PACKET_rx_buffer[i]);
+            }
+            printf("\n");
+            frames++;
+            break;
+            
+        case PACKET_RX_ERROR:
+            errors++;
+            break;
+            
+        default:
+            break;
+        }
+    }
+    
+    fprintf(stderr, "%lu frames, %lu bad frames\n", frames, errors);
+    
+    return (errors == 0) ? 0 : 1;
+}
+
+
+/*
+***************************************************************************************************
+**                                             MAIN
+***************************************************************************************************
+*/
+int main(int argc, char *argv[])
+{
+    PACKET_init(put_stdout);
+    
+    if ((argc == 2) && (strcmp(argv[1], "encode") == 0)) {
+        return encode();
+    }
+    
+    if ((argc == 2) && (strcmp(argv[1], "decode") == 0)) {
+        return decode();
+    }
+    
+    fprintf(stderr, "usage: %s encode|decode < input > output\n", argv[0]);
+    
+    return 2;
+}
@@ -0,0 +1,160 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: profile_tool.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Host (Linux) decoder for the timing report of Profile.c.
+*
+*              profile_tool < capture.bin       one block per call site
+*
+*              Send PROFILE_REQUEST (0x05) to the board and capture the answer, e.g.
+*              printf '\005' > /dev/rfcomm0; head -c 1000 /dev/rfcomm0 > capture.bin
+*              Bytes before the report (echoed data) are skipped.
+*
+***************************************************************************************************
+*/
+
+#include <stdio.h>
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define PROFILE_VERSION     1       /* Must match Profile.h */
+#define PROFILE_MAX_BUCKETS 16
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+static int read_8bit(unsigned long *value)
+{
+    int c = getchar();
+    
+    
+    if (c == EOF) {
+        return 0;
+    }
+    *value = (unsigned long)c;
+    return 1;
+}
+
+static int read_16bit(unsigned long *value)
+{
+    unsigned long low, high;
+    
+    
+    if (!read_8bit(&low) || !read_8bit(&high)) {
+        return 0;
+    }
+    *value = low | (high << 8);
+    return 1;
+}
+
+static int read_32bit(unsigned long *value)
+{
+    unsigned long low, high;
+    
+    
+    if (!read_16bit(&low) || !read_16bit(&high)) {
+        return 0;
+    }
+    *value = low | (high << 16);
+    return 1;
+}
+
+/* Skip to the 'P', 'R' at the start of the report */
+static int find_report(void)
+{
+    int c;
+    int last = EOF;
+    
+    
+    while ((c = getchar()) != EOF) {
+        if ((last == 'P') && (c == 'R')) {
+            return 1;
+        }
+        last = c;
+    }
+    return 0;
+}
+
+static int decode(void)
+{
+    unsigned long version, sites, buckets, shift, prescaler, khz;
+    unsigned long count, min, max, sum, histogram[PROFILE_MAX_BUCKETS];
+    unsigned long site, i;
+    double        us_per_tick;
+    
+    
+    if (!find_report()) {
+        fprintf(stderr, "no report found\n");
+        return 1;
+    }
+    
+    if (!read_8bit(&version) || !read_8bit(&sites) || !read_8bit(&buckets) || !read_8bit(&shift) ||
+        !read_16bit(&prescaler) || !read_16bit(&khz)) {
+        fprintf(stderr, "report header truncated\n");
+        return 1;
+    }
+    if ((version != PROFILE_VERSION) || (buckets < 2) || (buckets > PROFILE_MAX_BUCKETS) || (khz == 0)) {
+        fprintf(stderr, "unsupported report (version %lu, %lu buckets)\n", version, buckets);
+        return 1;
+    }
+    
+    us_per_tick = (double)prescaler * 1000.0 / (double)khz;
+    printf("F_CPU %lu kHz, %lu cycles per tick (%.3f us)\n", khz, prescaler, us_per_tick);
+    
+    for (site = 0; site < sites; site++) {
+        if (!read_16bit(&count) || !read_16bit(&min) || !read_16bit(&max) || !read_32bit(&sum)) {
+            fprintf(stderr, "report truncated at site %lu\n", site);
+            return 1;
+        }
+        for (i = 0; i < buckets; i++) {
+            if (!read_16bit(&histogram[i])) {
+                fprintf(stderr, "report truncated at site %lu\n", site);
+                return 1;
+            }
+        }
+        
+        printf("\nsite %lu: %lu calls", site, count);
+        if (count == 0) {
+            printf("\n");
+            continue;
+        }
+        printf(", min %lu, max %lu, mean %.1f ticks (%.1f / %.1f / %.1f us)%s\n", min, max,
+               (double)sum / count, min * us_per_tick, max * us_per_tick, (double)sum / count * us_per_tick,
+               (count == 65535) ? ", full" : "");
+        
+        for (i = 0; i < buckets; i++) {
+            unsigned long low = (i == 0) ? 0 : (1UL << (shift + i - 1));
+            
+            
+            if (i == buckets - 1) {
+                printf("  %7lu ... %7s ticks: %lu\n", low, "", histogram[i]);
+            } else {
+                printf("  %7lu ... %7lu ticks: %lu\n", low, (1UL << (shift + i)) - 1, histogram[i]);
+            }
+        }
+    }
+    
+    return 0;
+}
+
+
+/*
+***************************************************************************************************
+**                                             MAIN
+***************************************************************************************************
+*/
+int main(void)
+{
+    return decode();
+}
@@ -0,0 +1,136 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: trace_tool.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Host (Linux) decoder for the trace log of Trace.c.
+*
+*              trace_tool < capture.bin         one line per record
+*
+*              The format strings come from ../Trace_messages.h, so the tool must be built from
+*              the same version as the firmware. Other bytes on the serial line (e.g. echoed
+*              data) are skipped. A SYNC byte without a valid record is counted, the search goes
+*              on at the next byte, so a record that starts inside it is still found.
+*
+***************************************************************************************************
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define TRACE_SYNC          0xA5        /* Must match Trace.h */
+#define TRACE_MAX_ARGUMENTS 3
+
+typedef struct {
+    const char     *name;
+    unsigned int    arguments;
+    const char     *format;
+} trace_message;
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+#define TRACE_MESSAGE(name, arguments, format)  { #name, arguments, format },
+static const trace_message messages[] = {
+#include "../Trace_messages.h"
+};
+#undef TRACE_MESSAGE
+
+#define MESSAGES    (sizeof(messages) / sizeof(messages[0]))
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+static int decode(void)
+{
+    unsigned char *data = 0;
+    size_t         length = 0;
+    size_t         size = 0;
+    size_t         pos = 0;
+    int            c;
+    unsigned int   header, id, count, i;
+    unsigned int   values[TRACE_MAX_ARGUMENTS];
+    unsigned char  sum;
+    unsigned long  records = 0;
+    unsigned long  errors = 0;
+    
+    
+    while ((c = getchar()) != EOF) {                    /* Whole capture, a bad record is rescanned */
+        if (length == size) {
+            size = size ? 2 * size : 4096;
+            data = realloc(data, size);
+            if (data == 0) {
+                fprintf(stderr, "out of memory\n");
+                return 2;
+            }
+        }
+        data[length++] = (unsigned char)c;
+    }
+    
+    while (pos + 2 < length) {
+        if (data[pos] != TRACE_SYNC) {
+            pos++;                                      /* Not a trace record */
+            continue;
+        }
+        
+        header = data[pos + 1];
+        id = header >> 2;
+        count = header & 0x03;
+        if (pos + 3 + 2 * count > length) {
+            errors++;                                   /* Runs past the end of the capture, e.g. */
+            pos++;                                      /* a stray 0xA5 before the last records  */
+            continue;
+        }
+        
+        sum = (unsigned char)header;
+        for (i = 0; i < count; i++) {
+            values[i] = data[pos + 2 + 2 * i] | ((unsigned int)data[pos + 3 + 2 * i] << 8);
+            sum += (unsigned char)(data[pos + 2 + 2 * i] + data[pos + 3 + 2 * i]);
+        }
+        
+        if ((data[pos + 2 + 2 * count] != sum) || (id >= MESSAGES) || (messages[id].arguments != count)) {
+            errors++;                                   /* E.g. an echoed 0xA5, a record may start */
+            pos++;                                      /* in the bytes after it                   */
+            continue;
+        }
+        pos += 3 + 2 * count;
+        
+        for (i = count; i < TRACE_MAX_ARGUMENTS; i++) {
+            values[i] = 0;
+        }
+        printf(messages[id].format, values[0], values[1], values[2]);
+        printf("\n");
+        records++;
+    }
+    
+    free(data);
+    fprintf(stderr, "%lu records, %lu bad records\n", records, errors);
+    
+    return (errors == 0) ? 0 : 1;
+}
+
+
+/*
+***************************************************************************************************
+**                                             MAIN
+***************************************************************************************************
+*/
+int main(void)
+{
+    return decode();
+}
@@ -0,0 +1,261 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: Packet.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is a packet layer for a byte stream like the USART.
+*              Frames are SLIP encoded (RFC 1055) and end with a CRC-16/CCITT-FALSE (big endian).
+*              Encoding and CRC are done byte by byte on the way out, so nothing is buffered on
+*              the transmit side. The receiver decodes and checks the CRC on the fly into a single
+*              frame buffer.
+*
+*              Frame: END, SLIP(payload, CRC high, CRC low), END
+*
+*              This file does not use any AVR registers, it also builds on the host (see Host/).
+*
+***************************************************************************************************
+*/
+
+#include "Packet.h"
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_word(address)  (*(address))
+#endif
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+unsigned char PACKET_rx_buffer[PACKET_MAX_PAYLOAD + 2];
+unsigned char PACKET_rx_length = 0;
+
+static void (*PACKET_put_byte)(unsigned char byte);
+static uint16_t PACKET_tx_crc;
+
+static uint16_t      PACKET_rx_crc = PACKET_CRC_INIT;
+static unsigned char PACKET_rx_count = 0;       /* Decoded bytes of the current frame, incl. CRC */
+static bool          PACKET_rx_escaped = false;
+static bool          PACKET_rx_error = false;
+
+/* CRC of a 4 bit value, polynomial 0x1021. Only 32 bytes of flash instead of 512 for a byte table */
+static const uint16_t PACKET_crc_table[16] PROGMEM = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: PACKET_crc16_update
+* -----------------------------
+*   Add one byte to a CRC-16/CCITT-FALSE (nibble table, high nibble first).
+*
+*   crc:  current CRC (start with PACKET_CRC_INIT)
+*   byte: next byte
+*
+*   returns: new CRC
+*
+***************************************************************************************************
+*/
+uint16_t PACKET_crc16_update(uint16_t crc, unsigned char byte)
+{
+    crc = (uint16_t)(crc << 4) ^ pgm_read_word(&PACKET_crc_table[(crc >> 12) ^ (byte >> 4)]);
+    crc = (uint16_t)(crc << 4) ^ pgm_read_word(&PACKET_crc_table[(crc >> 12) ^ (byte & 0x0F)]);
+    
+    return crc;
+}
+
+/*
+***************************************************************************************************
+* Function: PACKET_init
+* ---------------------
+*   Initializes the packet layer.
+*
+*   put_byte: function that sends one byte, e.g. USART0_send_byte
+*
+***************************************************************************************************
+*/
+void PACKET_init(void (*put_byte)(unsigned char byte))
+{
+    PACKET_put_byte = put_byte;
+    
+    PACKET_rx_crc = PACKET_CRC_INIT;
+    PACKET_rx_count = 0;
+    PACKET_rx_escaped = false;
+    PACKET_rx_error = false;
+}
+
+/*
+***************************************************************************************************
+* Function: PACKET_put_escaped
+* ----------------------------
+*   Send a byte with SLIP escaping.
+*
+***************************************************************************************************
+*/
+static void PACKET_put_escaped(unsigned char byte)
+{
+    if (byte == PACKET_END) {
+        PACKET_put_byte(PACKET_ESC);
+        PACKET_put_byte(PACKET_ESC_END);
+    } else if (byte == PACKET_ESC) {
+        PACKET_put_byte(PACKET_ESC);
+        PACKET_put_byte(PACKET_ESC_ESC);
+    } else {
+        PACKET_put_byte(byte);
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: PACKET_send_begin
+* ---------------------------
+*   Start a new frame. The leading END flushes any line noise at the receiver.
+*
+***************************************************************************************************
+*/
+void PACKET_send_begin(void)
+{
+    PACKET_tx_crc = PACKET_CRC_INIT;
+    PACKET_put_byte(PACKET_END);
+}
+
+/*
+***************************************************************************************************
+* Function: PACKET_send_byte
+* --------------------------
+*   Add a payload byte to the current frame.
+*
+*   byte: payload byte
+*
+***************************************************************************************************
+*/
+void PACKET_send_byte(unsigned char byte)
+{
+    PACKET_tx_crc = PACKET_crc16_update(PACKET_tx_crc, byte);
+    PACKET_put_escaped(byte);
+}
+
+/*
+***************************************************************************************************
+* Function: PACKET_send_end
+* -------------------------
+*   Append the CRC and close the current frame.
+*
+***************************************************************************************************
+*/
+void PACKET_send_end(void)
+{
+    uint16_t crc = PACKET_tx_crc;
+    
+    
+    PACKET_put_escaped((unsigned char)(crc >> 8));
+    PACKET_put_escaped((unsigned char)crc);
+    PACKET_put_byte(PACKET_END);
+}
+
+/*
+***************************************************************************************************
+* Function: PACKET_send
+* ---------------------
+*   Send a complete frame.
+*
+*   data:   payload
+*   length: payload length
+*
+***************************************************************************************************
+*/
+void PACKET_send(const unsigned char *data, unsigned char length)
+{
+    PACKET_send_begin();
+    
+    while (length--) {
+        PACKET_send_byte(*data++);
+    }
+    
+    PACKET_send_end();
+}
+
+/*
+***************************************************************************************************
+* Function: PACKET_receive_byte
+* -----------------------------
+*   Feed one received byte into the frame decoder.
+*   After PACKET_RX_COMPLETE the payload is in PACKET_rx_buffer (PACKET_rx_length bytes). It is
+*   overwritten by the next frame, so use it before the next byte is fed in.
+*
+*   byte: received byte
+*
+*   returns: PACKET_RX_BUSY, PACKET_RX_COMPLETE or PACKET_RX_ERROR
+*
+***************************************************************************************************
+*/
+unsigned char PACKET_receive_byte(unsigned char byte)
+{
+    unsigned char result = PACKET_RX_BUSY;
+    
+    
+    if (byte == PACKET_END) {
+        if (PACKET_rx_error) {
+            result = PACKET_RX_ERROR;
+        } else if (PACKET_rx_count == 0) {
+            result = PACKET_RX_BUSY;                        /* Empty frame, e.g. leading END */
+        } else if ((PACKET_rx_count < 2) || PACKET_rx_escaped || (PACKET_rx_crc != 0)) {
+            result = PACKET_RX_ERROR;                       /* CRC over data and CRC is 0 if valid */
+        } else {
+            PACKET_rx_length = PACKET_rx_count - 2;
+            result = PACKET_RX_COMPLETE;
+        }
+    
+        PACKET_rx_crc = PACKET_CRC_INIT;
+        PACKET_rx_count = 0;
+        PACKET_rx_escaped = false;
+        PACKET_rx_error = false;
+    
+        return result;
+    }
+    
+    if (PACKET_rx_error) {
+        return PACKET_RX_BUSY;                              /* Skip the rest of a bad frame */
+    }
+    
+    if (PACKET_rx_escaped) {
+        PACKET_rx_escaped = false;
+    
+        if (byte == PACKET_ESC_END) {
+            byte = PACKET_END;
+        } else if (byte == PACKET_ESC_ESC) {
+            byte = PACKET_ESC;
+        } else {
+            PACKET_rx_error = true;                         /* Invalid escape sequence */
+            return PACKET_RX_BUSY;
+        }
+    } else if (byte == PACKET_ESC) {
+        PACKET_rx_escaped = true;
+        return PACKET_RX_BUSY;
+    }
+    
+    if (PACKET_rx_count >= sizeof(PACKET_rx_buffer)) {
+        PACKET_rx_error = true;                             /* Frame too long */
+        return PACKET_RX_BUSY;
+    }
+    
+    PACKET_rx_buffer[PACKET_rx_count++] = byte;
+    PACKET_rx_crc = PACKET_crc16_update(PACKET_rx_crc, byte);
+    
+    return PACKET_RX_BUSY;
+}
@@ -0,0 +1,82 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: Packet.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for Packet.c
+*
+***************************************************************************************************
+*/
+
+
+#ifndef PACKET_H_
+#define PACKET_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define PACKET_MAX_PAYLOAD  32          /* Maximum payload of a received packet in bytes (1...253) */
+
+/* End of configuration options. Change followings only if you know what you are doing.          */
+/* ********************************************************************************************* */
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+/* SLIP special characters (RFC 1055) */
+#define PACKET_END          0xC0        /* Frame delimiter              */
+#define PACKET_ESC          0xDB        /* Escape character             */
+#define PACKET_ESC_END      0xDC        /* ESC ESC_END -> END in data   */
+#define PACKET_ESC_ESC      0xDD        /* ESC ESC_ESC -> ESC in data   */
+
+#define PACKET_CRC_INIT     0xFFFF      /* CRC-16/CCITT-FALSE, polynomial 0x1021 */
+
+/* Return values of PACKET_receive_byte */
+#define PACKET_RX_BUSY      0           /* Frame not complete yet                   */
+#define PACKET_RX_COMPLETE  1           /* Valid frame in PACKET_rx_buffer          */
+#define PACKET_RX_ERROR     2           /* Frame dropped (CRC, escape or too long)  */
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+extern unsigned char PACKET_rx_buffer[PACKET_MAX_PAYLOAD + 2];     /* Payload and CRC of the last frame */
+extern unsigned char PACKET_rx_length;                             /* Payload length of the last frame  */
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+uint16_t PACKET_crc16_update(uint16_t crc, unsigned char byte);
+void PACKET_init(void (*put_byte)(unsigned char byte));
+void PACKET_send_begin(void);
+void PACKET_send_byte(unsigned char byte);
+void PACKET_send_end(void);
+void PACKET_send(const unsigned char *data, unsigned char length);
+unsigned char PACKET_receive_byte(unsigned char byte);
+
+
+
+#endif /* PACKET_H_ */
@@ -0,0 +1,189 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: Profile.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Timing of driver call sites with a free-running 16 bit timer.
+*              Every site keeps count, min, max, sum (for the mean) and a log2 histogram of its
+*              durations. PROFILE_dump sends them as a binary report via USART0, decoded by
+*              Host/profile_tool.
+*
+*              Report (little endian):
+*                'P', 'R', version, sites, buckets, bucket shift, prescaler (16 bit),
+*                F_CPU / 1000 (16 bit), then per site:
+*                count, min, max (16 bit each), sum (32 bit), buckets (16 bit each)
+*
+*              The durations include PROFILE_now of the exit (about 10 cycles) and the time
+*              spent in interrupts that hit the site.
+*
+***************************************************************************************************
+*/
+
+#include "Profile.h"
+
+#if PROFILE_ENABLE
+
+#include "USART.h"
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static PROFILE_site PROFILE_sites[PROFILE_SITES];
+static bool         PROFILE_paused = false;     /* While the report is sent */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: PROFILE_init
+* ----------------------
+*   Start the timer (normal mode, free-running) and clear the statistics.
+*
+***************************************************************************************************
+*/
+void PROFILE_init(void)
+{
+    PRR &= ~(1<<PROFILE_PRTIM);
+    PROFILE_TCCRA = 0;
+    PROFILE_TCCRB = PROFILE_CS;
+    
+    PROFILE_reset();
+}
+
+/*
+***************************************************************************************************
+* Function: PROFILE_reset
+* -----------------------
+*   Clear the statistics of all sites.
+*
+***************************************************************************************************
+*/
+void PROFILE_reset(void)
+{
+    unsigned char site;
+    unsigned char i;
+    
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (site = 0; site < PROFILE_SITES; ++site) {
+            PROFILE_sites[site].count = 0;
+            PROFILE_sites[site].min = 0xFFFF;
+            PROFILE_sites[site].max = 0;
+            PROFILE_sites[site].sum = 0;
+            for (i = 0; i < PROFILE_BUCKETS; ++i) {
+                PROFILE_sites[site].buckets[i] = 0;
+            }
+        }
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: PROFILE_record
+* ------------------------
+*   Add one duration to a site. Called by PROFILE_EXIT, also from ISRs.
+*
+*   site:  call site (0...PROFILE_SITES-1)
+*   ticks: duration in timer ticks
+*
+***************************************************************************************************
+*/
+void PROFILE_record(unsigned char site, unsigned int ticks)
+{
+    PROFILE_site  *stats = &PROFILE_sites[site];
+    unsigned int   rest = ticks >> PROFILE_BUCKET_SHIFT;
+    unsigned char  bucket = 0;
+    
+    
+    while (rest && (bucket < PROFILE_BUCKETS - 1)) {    /* log2 without multiplier */
+        rest >>= 1;
+        bucket++;
+    }
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (!PROFILE_paused && (stats->count != 0xFFFF)) {  /* Stop when full, the mean stays right */
+            stats->count++;
+            stats->sum += ticks;
+            if (ticks < stats->min) {
+                stats->min = ticks;
+            }
+            if (ticks > stats->max) {
+                stats->max = ticks;
+            }
+            stats->buckets[bucket]++;
+        }
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: PROFILE_send_16bit
+* ----------------------------
+*   Send a 16 bit value, low byte first.
+*
+***************************************************************************************************
+*/
+static void PROFILE_send_16bit(unsigned int value)
+{
+    USART0_send_byte((unsigned char)value);
+    USART0_send_byte((unsigned char)(value >> 8));
+}
+
+/*
+***************************************************************************************************
+* Function: PROFILE_dump
+* ----------------------
+*   Send the report via USART0. The sites are not updated while it is sent, so the report does
+*   not measure itself: samples taken during the report are dropped. Each site is copied
+*   atomically.
+*
+***************************************************************************************************
+*/
+void PROFILE_dump(void)
+{
+    PROFILE_site  copy;
+    unsigned char site;
+    unsigned char i;
+    
+    
+    PROFILE_paused = true;
+    
+    USART0_send_byte('P');
+    USART0_send_byte('R');
+    USART0_send_byte(PROFILE_VERSION);
+    USART0_send_byte(PROFILE_SITES);
+    USART0_send_byte(PROFILE_BUCKETS);
+    USART0_send_byte(PROFILE_BUCKET_SHIFT);
+    PROFILE_send_16bit(PROFILE_PRESCALER);
+    PROFILE_send_16bit((unsigned int)(F_CPU / 1000UL));
+    
+    for (site = 0; site < PROFILE_SITES; ++site) {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            copy = PROFILE_sites[site];
+        }
+    
+        PROFILE_send_16bit(copy.count);
+        PROFILE_send_16bit(copy.min);
+        PROFILE_send_16bit(copy.max);
+        PROFILE_send_16bit((unsigned int)copy.sum);
+        PROFILE_send_16bit((unsigned int)(copy.sum >> 16));
+        for (i = 0; i < PROFILE_BUCKETS; ++i) {
+            PROFILE_send_16bit(copy.buckets[i]);
+        }
+    }
+    
+    PROFILE_paused = false;
+}
+
+#endif /* PROFILE_ENABLE */
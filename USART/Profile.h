@@ -0,0 +1,158 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: Profile.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for Profile.c
+*
+*              A call site is timed with PROFILE_ENTER(site) as the last local declaration and
+*              PROFILE_EXIT(site) before the return. Sites set to PROFILE_OFF and all sites with
+*              PROFILE_ENABLE 0 produce no code.
+*
+***************************************************************************************************
+*/
+
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define PROFILE_ENABLE          0       /* 1 -> call sites are timed, 0 -> no code and no RAM      */
+#define PROFILE_TIMER           1       /* Free-running 16 bit timer: 1 or 2 (2 with I2C_Async)    */
+#define PROFILE_PRESCALER       1       /* 1, 8, 64, 256 or 1024 CPU cycles per timer tick         */
+#define PROFILE_BUCKETS         10      /* Histogram buckets per site (2...16)                     */
+#define PROFILE_BUCKET_SHIFT    3       /* Bucket 0: < 2^SHIFT ticks, bucket n: 2^(SHIFT+n-1) ...  */
+                                        /* 2^(SHIFT+n)-1 ticks, the last bucket takes the rest     */
+#define PROFILE_REQUEST         0x05    /* Received byte that asks for a report (ENQ)              */
+
+/* Call sites, numbered from 0. Every site takes 10 + 2 * PROFILE_BUCKETS bytes of SRAM. */
+#define USART0_PROFILE_SEND_BYTE    0   /* USART0_send_byte             */
+#define USART0_PROFILE_RX           1   /* ISR (USART0_RX_vect)         */
+#define I2C_PROFILE_READ_16BIT      2   /* I2C_read_16bit_addr          */
+#define PROFILE_SITES               3
+
+#define USART1_PROFILE_SEND_BYTE    PROFILE_OFF
+#define USART1_PROFILE_RX           PROFILE_OFF
+#define I2C2_PROFILE_READ_16BIT     PROFILE_OFF
+
+/* End of configuration options. Change followings only if you know what you are doing.          */
+/* ********************************************************************************************* */
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define PROFILE_OFF             0xFF    /* Site is not timed */
+#define PROFILE_VERSION         1       /* Report format */
+
+#define PROFILE_PASTE(a, n, b)  a##n##b
+#define PROFILE_XPASTE(a, n, b) PROFILE_PASTE(a, n, b)
+#define PROFILE_TCNT            PROFILE_XPASTE(TCNT, PROFILE_TIMER, )       /* TCNT1 */
+#define PROFILE_TCCRA           PROFILE_XPASTE(TCCR, PROFILE_TIMER, A)      /* TCCR1A */
+#define PROFILE_TCCRB           PROFILE_XPASTE(TCCR, PROFILE_TIMER, B)      /* TCCR1B */
+#define PROFILE_PRTIM           PROFILE_XPASTE(PRTIM, PROFILE_TIMER, )      /* PRTIM1 */
+
+#if PROFILE_ENABLE
+#if (PROFILE_TIMER != 1) && (PROFILE_TIMER != 2)
+#error "PROFILE_TIMER must be 1 or 2 (16 bit timers)"
+#endif
+#if (PROFILE_BUCKETS < 2) || (PROFILE_BUCKETS > 16) || (PROFILE_SITES < 1) || (PROFILE_SITES >= PROFILE_OFF)
+#error "PROFILE_BUCKETS or PROFILE_SITES out of range"
+#endif
+#endif
+
+/* Clock select bits of the prescaler */
+#if PROFILE_PRESCALER == 1
+#define PROFILE_CS              1
+#elif PROFILE_PRESCALER == 8
+#define PROFILE_CS              2
+#elif PROFILE_PRESCALER == 64
+#define PROFILE_CS              3
+#elif PROFILE_PRESCALER == 256
+#define PROFILE_CS              4
+#elif PROFILE_PRESCALER == 1024
+#define PROFILE_CS              5
+#else
+#error "PROFILE_PRESCALER must be 1, 8, 64, 256 or 1024"
+#endif
+
+/* Statistics of one call site, durations in timer ticks */
+typedef struct {
+    unsigned int    count;                      /* Calls, stops at 65535                   */
+    unsigned int    min;
+    unsigned int    max;
+    unsigned long   sum;                        /* mean = sum / count                      */
+    unsigned int    buckets[PROFILE_BUCKETS];   /* Histogram, log2 of the duration         */
+} PROFILE_site;
+
+#if PROFILE_ENABLE
+#define PROFILE_ENTER(site)     unsigned int PROFILE_start = ((site) < PROFILE_SITES) ? PROFILE_now() : 0
+#define PROFILE_EXIT(site)      do {                                                            \
+                                    if ((site) < PROFILE_SITES) {                               \
+                                        PROFILE_record((site), PROFILE_now() - PROFILE_start);  \
+                                    }                                                           \
+                                } while (0)
+#else
+#define PROFILE_ENTER(site)
+#define PROFILE_EXIT(site)      do { } while (0)
+#define PROFILE_init()          do { } while (0)
+#define PROFILE_reset()         do { } while (0)
+#define PROFILE_dump()          do { } while (0)
+#endif
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include <avr/io.h>
+#include <util/atomic.h>
+#include <stdbool.h>
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+#if PROFILE_ENABLE
+void PROFILE_init(void);
+void PROFILE_reset(void);
+void PROFILE_record(unsigned char site, unsigned int ticks);
+void PROFILE_dump(void);
+
+/*
+***************************************************************************************************
+* Function: PROFILE_now
+* ---------------------
+*   returns: timer count. Read with interrupts disabled, an ISR reading the timer in between
+*            would overwrite the shared TEMP register of the 16 bit access.
+*
+***************************************************************************************************
+*/
+static inline unsigned int PROFILE_now(void)
+{
+    unsigned int ticks = 0;
+    
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ticks = PROFILE_TCNT;
+    }
+    return ticks;
+}
+#endif
+
+
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,157 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: Trace.c
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Binary trace log. A trace call stores only the message ID and its raw arguments
+*              in a ring buffer (a few cycles, also from ISRs). TRACE_poll moves complete
+*              records into the transmit buffer of USART0 without waiting, USART_sleep calls it
+*              before the CPU sleeps. Host/trace_tool prints them with the format strings of
+*              Trace_messages.h, which never get into the firmware.
+*
+*              If the buffer is full, records are dropped and counted, the count is sent as
+*              TRACE_DROPPED once there is space again.
+*
+***************************************************************************************************
+*/
+
+#include "Trace.h"
+
+#if TRACE_ENABLE
+
+#include "USART.h"
+
+#if !USART0_ENABLE
+#error "TRACE_ENABLE needs USART0_ENABLE, the records are sent via USART0"
+#endif
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static unsigned char          TRACE_buffer[TRACE_BUFFER_SIZE];
+static volatile unsigned char TRACE_head = 0;       /* Written by TRACE_put only  */
+static volatile unsigned char TRACE_tail = 0;       /* Written by TRACE_poll only */
+static volatile unsigned int  TRACE_dropped = 0;
+
+/* 6 bits for the ID in a record */
+typedef char TRACE_ids_check[(TRACE_MESSAGES <= 64) ? 1 : -1];
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: TRACE_put
+* -------------------
+*   Store a record, use the TRACE0...TRACE3 macros instead. Can also be used from an ISR.
+*
+*   id:        message ID
+*   arguments: number of arguments (0...3)
+*   a, b, c:   arguments
+*
+***************************************************************************************************
+*/
+void TRACE_put(unsigned char id, unsigned char arguments, unsigned int a, unsigned int b, unsigned int c)
+{
+    unsigned char header = (id << 2) | arguments;
+    unsigned char sum = header;
+    unsigned char head;
+    unsigned int  value;
+    
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        head = TRACE_head;
+        
+        if (((TRACE_tail - head - 1) & TRACE_BUFFER_MASK) < TRACE_RECORD_SIZE(arguments)) {
+            if (TRACE_dropped != 0xFFFF) {
+                TRACE_dropped++;
+            }
+        } else {
+            TRACE_buffer[head] = TRACE_SYNC;
+            head = (head + 1) & TRACE_BUFFER_MASK;
+            TRACE_buffer[head] = header;
+            head = (head + 1) & TRACE_BUFFER_MASK;
+            
+            while (arguments--) {
+                value = a;
+                a = b;                                      /* Next argument */
+                b = c;
+                
+                TRACE_buffer[head] = (unsigned char)value;
+                head = (head + 1) & TRACE_BUFFER_MASK;
+                TRACE_buffer[head] = (unsigned char)(value >> 8);
+                head = (head + 1) & TRACE_BUFFER_MASK;
+                sum += (unsigned char)value + (unsigned char)(value >> 8);
+            }
+            
+            TRACE_buffer[head] = sum;
+            TRACE_head = (head + 1) & TRACE_BUFFER_MASK;    /* Record is visible to TRACE_poll */
+        }
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: TRACE_pending
+* -----------------------
+*   returns: true if records wait for TRACE_poll
+*
+***************************************************************************************************
+*/
+bool TRACE_pending(void)
+{
+    return (TRACE_head != TRACE_tail) || (TRACE_dropped != 0);
+}
+
+/*
+***************************************************************************************************
+* Function: TRACE_poll
+* --------------------
+*   Move complete records into the transmit buffer of USART0, as many as fit without waiting.
+*   Records are never split, so bytes sent by the main loop cannot end up inside a record.
+*   Call it from the main loop only.
+*
+***************************************************************************************************
+*/
+void TRACE_poll(void)
+{
+    unsigned char tail = TRACE_tail;
+    unsigned char size;
+    unsigned int  dropped;
+    
+    
+    while (tail != TRACE_head) {
+        size = TRACE_RECORD_SIZE(TRACE_buffer[(tail + 1) & TRACE_BUFFER_MASK] & 0x03);
+        if (USART0_tx_free() < size) {
+            break;
+        }
+        
+        while (size--) {
+            USART0_put_byte(TRACE_buffer[tail]);
+            tail = (tail + 1) & TRACE_BUFFER_MASK;
+        }
+        TRACE_tail = tail;
+    }
+    
+    if (TRACE_dropped != 0) {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            if (((TRACE_tail - TRACE_head - 1) & TRACE_BUFFER_MASK) >= TRACE_RECORD_SIZE(1)) {
+                dropped = TRACE_dropped;
+                TRACE_dropped = 0;
+                TRACE_put(TRACE_DROPPED, 1, dropped, 0, 0);
+            }
+        }
+    }
+}
+
+#endif /* TRACE_ENABLE */
@@ -0,0 +1,106 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: Trace.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: This is the header file for Trace.c
+*
+*              TRACE0(id) ... TRACE3(id, a, b, c) log a message of Trace_messages.h. The number
+*              of arguments is checked at compile time. With TRACE_ENABLE 0 the macros produce
+*              no code.
+*
+***************************************************************************************************
+*/
+
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+
+/*
+***************************************************************************************************
+**                                         USER DEFINES
+***************************************************************************************************
+*/
+#define TRACE_ENABLE            0       /* 1 -> trace records are sent via USART0, 0 -> no code   */
+#define TRACE_BUFFER_SIZE       32      /* Record buffer in bytes, power of two (8...128)         */
+
+/* End of configuration options. Change followings only if you know what you are doing.          */
+/* ********************************************************************************************* */
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+/* Record: TRACE_SYNC, id << 2 | arguments, arguments (16 bit, little endian), checksum
+ * The checksum is the 8 bit sum of the bytes between TRACE_SYNC and the checksum. */
+#define TRACE_SYNC              0xA5
+#define TRACE_RECORD_SIZE(n)    (3 + 2 * (n))
+#define TRACE_BUFFER_MASK       (TRACE_BUFFER_SIZE - 1)
+
+#if TRACE_ENABLE
+#if (TRACE_BUFFER_SIZE < 8) || (TRACE_BUFFER_SIZE > 128) || (TRACE_BUFFER_SIZE & TRACE_BUFFER_MASK)
+#error "TRACE_BUFFER_SIZE must be a power of two between 8 and 128"
+#endif
+#endif
+
+/* Message IDs and their number of arguments (name_ARGUMENTS) */
+#define TRACE_MESSAGE(name, arguments, format)  name,
+typedef enum {
+#include "Trace_messages.h"
+    TRACE_MESSAGES
+} TRACE_id;
+#undef TRACE_MESSAGE
+
+#define TRACE_MESSAGE(name, arguments, format)  name##_ARGUMENTS = (arguments),
+enum {
+#include "Trace_messages.h"
+};
+#undef TRACE_MESSAGE
+
+/* Compile error if the number of arguments does not match Trace_messages.h */
+#define TRACE_CHECK(id, n)      ((void)sizeof(char[(id##_ARGUMENTS == (n)) ? 1 : -1]))
+
+#if TRACE_ENABLE
+#define TRACE0(id)              do { TRACE_CHECK(id, 0); TRACE_put((id), 0, 0, 0, 0); } while (0)
+#define TRACE1(id, a)           do { TRACE_CHECK(id, 1); TRACE_put((id), 1, (a), 0, 0); } while (0)
+#define TRACE2(id, a, b)        do { TRACE_CHECK(id, 2); TRACE_put((id), 2, (a), (b), 0); } while (0)
+#define TRACE3(id, a, b, c)     do { TRACE_CHECK(id, 3); TRACE_put((id), 3, (a), (b), (c)); } while (0)
+#else
+#define TRACE0(id)              do { TRACE_CHECK(id, 0); } while (0)
+#define TRACE1(id, a)           do { TRACE_CHECK(id, 1); (void)(a); } while (0)
+#define TRACE2(id, a, b)        do { TRACE_CHECK(id, 2); (void)(a); (void)(b); } while (0)
+#define TRACE3(id, a, b, c)     do { TRACE_CHECK(id, 3); (void)(a); (void)(b); (void)(c); } while (0)
+#define TRACE_poll()            do { } while (0)
+#endif
+
+
+/*
+***************************************************************************************************
+**                                           INCLUDES
+***************************************************************************************************
+*/
+#include <avr/io.h>
+#include <util/atomic.h>
+#include <stdbool.h>
+
+
+/*
+***************************************************************************************************
+**                                      FUNCTION PROTOTYPES
+***************************************************************************************************
+*/
+#if TRACE_ENABLE
+void TRACE_put(unsigned char id, unsigned char arguments, unsigned int a, unsigned int b, unsigned int c);
+void TRACE_poll(void);
+bool TRACE_pending(void);
+#endif
+
+
+
+#endif /* TRACE_H_ */
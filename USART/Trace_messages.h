@@ -0,0 +1,31 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: Trace_messages.h
+*
+* Created: 17.10.2026
+* Author:  M. Schuepbach
+*
+* Description: Messages of the trace log, one line per message:
+*
+*              TRACE_MESSAGE(name, arguments, "format")
+*
+*              name:      ID used with TRACE0...TRACE3 in the firmware
+*              arguments: number of 16 bit arguments (0...3)
+*              format:    printf format for the host, one %u/%X/... per argument
+*
+*              The firmware only keeps the IDs, the format strings are used by Host/trace_tool.
+*              IDs are numbered in this order (at most 64), only append new messages so old
+*              captures stay readable.
+*
+*              No include guard, this file is meant to be included more than once.
+*
+***************************************************************************************************
+*/
+
+TRACE_MESSAGE(TRACE_DROPPED,            1, "%u trace records dropped (buffer full)")
+TRACE_MESSAGE(TRACE_I2C_NACK,           1, "I2C: NACK for byte 0x%02X")
+TRACE_MESSAGE(TRACE_I2C_ARBITRATION,    0, "I2C: arbitration lost (SDA low while sending 1)")
+TRACE_MESSAGE(TRACE_I2C_TIMEOUT,        0, "I2C: SCL held low too long (clock stretching timeout)")
+TRACE_MESSAGE(TRACE_I2C_BUS,            0, "I2C: SDA stuck low after stop")
+TRACE_MESSAGE(TRACE_USART_RX_ERROR,     2, "USART%u: receive error, status 0x%02X")
@@ -6,20 +6,33 @@
 * Created: 18.05.2017
 * Author:  M. Schuepbach
 *
-* Description: This is a USART Driver.
+* Description: This is a USART Driver for USART0 and USART1.
+*              The driver code of one port is in USART_port.h, it is built once per enabled port.
 *
 ***************************************************************************************************
 */
 
 #include "USART.h"
+#include "Profile.h"
+#include "Trace.h"
 
 
 /*
 ***************************************************************************************************
-**                                  GLOBAL VARIABLES AND ARRAYS
+**                                      USART PORT DRIVERS
 ***************************************************************************************************
 */
-// Initialize global variables or arrays here
+#if USART0_ENABLE
+#define USART_N 0
+#include "USART_port.h"
+#undef USART_N
+#endif
+
+#if USART1_ENABLE
+#define USART_N 1
+#include "USART_port.h"
+#undef USART_N
+#endif
 
 
 /*
@@ -30,37 +43,74 @@
 
 /*
 ***************************************************************************************************
-* Function: USART0_init
+* Function: USART_sleep
 * ---------------------
-*   Initializes USART0
-*   Settings: Asynchronous, 8 data bits, none parity, 1 stop bit
+*   Sleep until the next interrupt if no received bytes are waiting. Call it in the main loop
+*   once all work is done.
+*   Idle while a transmitter is busy (the UDRE interrupt needs the clock). Otherwise Power-down
+*   if USART_SLEEP_POWER_DOWN is 1: the start frame detector of each powered port wakes the CPU
+*   on the start bit, the oscillator starts in time to receive that frame at the usual baud
+*   rates. Other wake-up sources (pin change, INT0, WDT) also work, timers do not.
+*   Waiting trace records are moved to the transmit buffer first. Records that do not fit
+*   keep the CPU in Idle until the next byte is sent.
 *
 ***************************************************************************************************
 */
-void USART0_init(void)
+void USART_sleep(void)
 {
-    UBRR0H = (unsigned char)(BAUDRATE>>8);          /* Set baud rate */
-    UBRR0L = (unsigned char)BAUDRATE;
+    unsigned char mode = USART_SLEEP_POWER_DOWN ? SLEEP_MODE_PWR_DOWN : SLEEP_MODE_IDLE;
     
-    UCSR0A = (1<<RXC0);                             /* Set Receive Complete flag, needed for interrupt */
-    UCSR0B = (1<<RXCIE0)|(1<<RXEN0)|(1<<TXEN0);     /* Enable Receive Complete Interrupt, receiver and transmitter */
     
-    sei();
-}
-
-/*
-***************************************************************************************************
-* Function: USART0_send_byte
-* --------------------------
-*   Send byte via USART0
-*
-*   byte_to_send: Byte that should me sent via USART0
-*
-***************************************************************************************************
-*/
-void USART0_send_byte(unsigned char byte_to_send)
-{
-    while( !(UCSR0A & (1<<UDRE0)) );    /* Wait for empty buffer */
+    TRACE_poll();
+    
+    cli();                                              /* A byte arriving now must not be missed */
+    
+#if TRACE_ENABLE && USART0_ENABLE                      /* Trace.c stops the build without USART0 */
+    if (TRACE_pending()) {
+        if (!USART0_tx_queued()) {
+            sei();                                      /* Traced by an ISR after the poll, poll again */
+            return;
+        }
+        mode = SLEEP_MODE_IDLE;                         /* No space, the UDRE interrupt wakes the CPU */
+    }
+#endif
+    
+#if USART0_ENABLE
+    if (USART0_available()) {
+        sei();
+        return;
+    }
+    if (!USART0_tx_idle()) {
+        mode = SLEEP_MODE_IDLE;
+    }
+#endif
+    
+#if USART1_ENABLE
+    if (USART1_available()) {
+        sei();
+        return;
+    }
+    if (!USART1_tx_idle()) {
+        mode = SLEEP_MODE_IDLE;
+    }
+#endif
+    
+    if (mode == SLEEP_MODE_PWR_DOWN) {
+#if USART0_ENABLE
+        if (!(PRR & (1<<PRUSART0))) {
+            UCSR0D = (1<<RXS0)|(1<<RXSIE0)|(1<<SFDE0);  /* Clear old start flag, wake on start bit */
+        }
+#endif
+#if USART1_ENABLE
+        if (!(PRR & (1<<PRUSART1))) {
+            UCSR1D = (1<<RXS1)|(1<<RXSIE1)|(1<<SFDE1);
+        }
+#endif
+    }
     
-    UDR0 = byte_to_send;	/* Transmission starts */
+    set_sleep_mode(mode);
+    sleep_enable();
+    sei();                                              /* The next instruction is executed before */
+    sleep_cpu();                                        /* any interrupt, so no wake-up is lost    */
+    sleep_disable();
 }
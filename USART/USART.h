@@ -21,9 +21,51 @@
 **                                         USER DEFINES
 ***************************************************************************************************
 */
+#ifndef F_CPU                       /* Other projects that build USART.c set it in the build symbols */
 #define F_CPU   8000000UL           /* F_osc=8MHz & CKDIV=1 -> 8MHz / 1 = 8MHz */
-
-#define BAUD    9600
+#endif
+
+#define BAUD_TOLERANCE  21          /* Maximum allowed baud rate error in 0.1% (21 -> 2.1%) */
+
+#define USART_SLEEP_POWER_DOWN  1               /* 1 -> USART_sleep uses Power-down if nothing is sent, */
+                                                /* the start bit of the next frame wakes the CPU.      */
+                                                /* 0 -> Idle only (e.g. external clock, high baud)     */
+
+/* USART0 */
+#define USART0_ENABLE           1               /* 1 -> driver for USART0 is built, 0 -> not built */
+#define USART0_BAUD             9600
+#define USART0_DATA_BITS        8               /* 5...8 */
+#define USART0_PARITY           USART_PARITY_NONE
+#define USART0_STOP_BITS        1               /* 1 or 2 */
+#define USART0_TX_BUFFER_SIZE   32  /* Size of the transmit ring buffer, must be a power of two (2...128) */
+#define USART0_RX_BUFFER_SIZE   32  /* Size of the receive ring buffer, must be a power of two (2...128)  */
+#define USART0_FLOW_CONTROL     0               /* 1 -> RTS/CTS hardware flow control, 0 -> none   */
+#define USART0_RTS_PORT         PORTA           /* RTS output (active low), we may receive if low  */
+#define USART0_RTS_DDR          DDRA
+#define USART0_RTS_BIT          3
+#define USART0_CTS_PIN          PINA            /* CTS input (active low), we may send if low      */
+#define USART0_CTS_DDR          DDRA
+#define USART0_CTS_BIT          7
+#define USART0_RX_HIGH_WATERMARK    (USART0_RX_BUFFER_SIZE - 8)     /* Release RTS at this fill level */
+#define USART0_RX_LOW_WATERMARK     (USART0_RX_BUFFER_SIZE / 4)     /* Assert RTS again at this level */
+
+/* USART1 */
+#define USART1_ENABLE           0               /* 1 -> driver for USART1 is built, 0 -> not built */
+#define USART1_BAUD             9600
+#define USART1_DATA_BITS        8               /* 5...8 */
+#define USART1_PARITY           USART_PARITY_NONE
+#define USART1_STOP_BITS        1               /* 1 or 2 */
+#define USART1_TX_BUFFER_SIZE   32  /* Size of the transmit ring buffer, must be a power of two (2...128) */
+#define USART1_RX_BUFFER_SIZE   32  /* Size of the receive ring buffer, must be a power of two (2...128)  */
+#define USART1_FLOW_CONTROL     0               /* 1 -> RTS/CTS hardware flow control, 0 -> none   */
+#define USART1_RTS_PORT         PORTB           /* RTS output (active low), we may receive if low  */
+#define USART1_RTS_DDR          DDRB
+#define USART1_RTS_BIT          0
+#define USART1_CTS_PIN          PINB            /* CTS input (active low), we may send if low      */
+#define USART1_CTS_DDR          DDRB
+#define USART1_CTS_BIT          1
+#define USART1_RX_HIGH_WATERMARK    (USART1_RX_BUFFER_SIZE - 8)     /* Release RTS at this fill level */
+#define USART1_RX_LOW_WATERMARK     (USART1_RX_BUFFER_SIZE / 4)     /* Assert RTS again at this level */
 
 /* End of configuration options. Change followings only if you know what you are doing.          */
 /* ********************************************************************************************* */
@@ -34,8 +76,114 @@
 **                                   SYSTEM DEFINES AND MACROS
 ***************************************************************************************************
 */
-#define BAUDRATE    ((F_CPU / (BAUD * 16UL)) - 1)
-
+#define USART_PARITY_NONE   0
+#define USART_PARITY_EVEN   2
+#define USART_PARITY_ODD    3
+
+/* Baud rate solver, evaluated by the preprocessor:
+ * The rounded UBRR value is calculated for normal (16x) and double speed (8x) mode. The mode with
+ * the lower error wins (normal mode on a tie). USART_UBRR is the UBRR value, USART_USE_2X the U2X
+ * bit, USART_BAUD_ACTUAL the achieved baud rate and USART_BAUD_ERROR the error in 0.1%.
+ */
+#define USART_UBRR_16X(baud)        ((F_CPU + 8UL * (baud)) / (16UL * (baud)) - 1)
+#define USART_UBRR_8X(baud)         ((F_CPU + 4UL * (baud)) / (8UL * (baud)) - 1)
+#define USART_ACTUAL_16X(baud)      (F_CPU / (16UL * (USART_UBRR_16X(baud) + 1)))
+#define USART_ACTUAL_8X(baud)       (F_CPU / (8UL * (USART_UBRR_8X(baud) + 1)))
+#define USART_DIFF(actual, baud)    (((actual) > (baud)) ? ((actual) - (baud)) : ((baud) - (actual)))
+
+#define USART_USE_2X(baud)          ((USART_UBRR_8X(baud) <= 4095) &&                                     \
+                                     ((USART_UBRR_16X(baud) > 4095) ||                                     \
+                                      (USART_DIFF(USART_ACTUAL_8X(baud), baud) < USART_DIFF(USART_ACTUAL_16X(baud), baud))))
+#define USART_UBRR(baud)            (USART_USE_2X(baud) ? USART_UBRR_8X(baud) : USART_UBRR_16X(baud))
+#define USART_BAUD_ACTUAL(baud)     (USART_USE_2X(baud) ? USART_ACTUAL_8X(baud) : USART_ACTUAL_16X(baud))
+#define USART_BAUD_ERROR(baud)      ((USART_DIFF(USART_BAUD_ACTUAL(baud), baud) * 1000UL + (baud) / 2) / (baud))
+
+/* Frame format for UCSRnC (asynchronous mode), bit positions are the same for both USARTs */
+#define USART_FRAME(data_bits, parity, stop_bits)                                                 \
+    ((((data_bits) - 5) << UCSZ00) | ((parity) << UPM00) | (((stop_bits) - 1) << USBS0))
+
+#define USART0_BAUDRATE         USART_UBRR(USART0_BAUD)
+#define USART0_USE_2X           USART_USE_2X(USART0_BAUD)
+#define USART0_BAUD_ACTUAL      USART_BAUD_ACTUAL(USART0_BAUD)
+#define USART0_BAUD_ERROR       USART_BAUD_ERROR(USART0_BAUD)
+#define USART0_TX_BUFFER_MASK   (USART0_TX_BUFFER_SIZE - 1)
+#define USART0_RX_BUFFER_MASK   (USART0_RX_BUFFER_SIZE - 1)
+
+#define USART1_BAUDRATE         USART_UBRR(USART1_BAUD)
+#define USART1_USE_2X           USART_USE_2X(USART1_BAUD)
+#define USART1_BAUD_ACTUAL      USART_BAUD_ACTUAL(USART1_BAUD)
+#define USART1_BAUD_ERROR       USART_BAUD_ERROR(USART1_BAUD)
+#define USART1_TX_BUFFER_MASK   (USART1_TX_BUFFER_SIZE - 1)
+#define USART1_RX_BUFFER_MASK   (USART1_RX_BUFFER_SIZE - 1)
+
+/* Configuration checks */
+#if USART0_ENABLE
+#if (F_CPU < 8UL * USART0_BAUD) || (USART0_BAUDRATE > 4095)
+#error "USART0_BAUD is out of range for F_CPU"
+#endif
+#if (USART0_BAUD_ERROR > BAUD_TOLERANCE)
+#error "USART0 baud rate error is higher than BAUD_TOLERANCE, change USART0_BAUD or F_CPU"
+#endif
+#if (USART0_DATA_BITS < 5) || (USART0_DATA_BITS > 8) || (USART0_STOP_BITS < 1) || (USART0_STOP_BITS > 2)
+#error "USART0 frame format is not supported"
+#endif
+#if (USART0_TX_BUFFER_SIZE < 2) || (USART0_TX_BUFFER_SIZE > 128) || (USART0_TX_BUFFER_SIZE & USART0_TX_BUFFER_MASK)
+#error "USART0_TX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#if (USART0_RX_BUFFER_SIZE < 2) || (USART0_RX_BUFFER_SIZE > 128) || (USART0_RX_BUFFER_SIZE & USART0_RX_BUFFER_MASK)
+#error "USART0_RX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#if USART0_FLOW_CONTROL && ((USART0_RX_LOW_WATERMARK >= USART0_RX_HIGH_WATERMARK) || (USART0_RX_HIGH_WATERMARK >= USART0_RX_BUFFER_SIZE))
+#error "USART0 watermarks must be LOW < HIGH < RX_BUFFER_SIZE"
+#endif
+#endif /* USART0_ENABLE */
+
+#if USART1_ENABLE
+#if (F_CPU < 8UL * USART1_BAUD) || (USART1_BAUDRATE > 4095)
+#error "USART1_BAUD is out of range for F_CPU"
+#endif
+#if (USART1_BAUD_ERROR > BAUD_TOLERANCE)
+#error "USART1 baud rate error is higher than BAUD_TOLERANCE, change USART1_BAUD or F_CPU"
+#endif
+#if (USART1_DATA_BITS < 5) || (USART1_DATA_BITS > 8) || (USART1_STOP_BITS < 1) || (USART1_STOP_BITS > 2)
+#error "USART1 frame format is not supported"
+#endif
+#if (USART1_TX_BUFFER_SIZE < 2) || (USART1_TX_BUFFER_SIZE > 128) || (USART1_TX_BUFFER_SIZE & USART1_TX_BUFFER_MASK)
+#error "USART1_TX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#if (USART1_RX_BUFFER_SIZE < 2) || (USART1_RX_BUFFER_SIZE > 128) || (USART1_RX_BUFFER_SIZE & USART1_RX_BUFFER_MASK)
+#error "USART1_RX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#if USART1_FLOW_CONTROL && ((USART1_RX_LOW_WATERMARK >= USART1_RX_HIGH_WATERMARK) || (USART1_RX_HIGH_WATERMARK >= USART1_RX_BUFFER_SIZE))
+#error "USART1 watermarks must be LOW < HIGH < RX_BUFFER_SIZE"
+#endif
+#endif /* USART1_ENABLE */
+
+/* Error counters of one USART port */
+typedef struct {
+    unsigned int overrun;       /* Data OverRun, byte(s) lost in hardware           */
+    unsigned int framing;       /* Frame Error, stop bit was 0 (byte dropped)       */
+    unsigned int parity;        /* Parity Error (byte dropped)                      */
+    unsigned int dropped;       /* Receive buffer was full (byte dropped)           */
+} USART_errors;
+
+/* Function prototypes of one USART port, n: 0 or 1 */
+#define USART_PROTOTYPES(n)                                                                       \
+void USART##n##_init(void);                                                                       \
+void USART##n##_send_byte(unsigned char byte_to_send);                                            \
+void USART##n##_send_buffer(const unsigned char *buffer, unsigned int length);                    \
+void USART##n##_send_string(const char *string);                                                  \
+void USART##n##_send_P(const char *string);                                                       \
+bool USART##n##_put_byte(unsigned char byte_to_send);                                             \
+unsigned char USART##n##_tx_free(void);                                                           \
+void USART##n##_flush(void);                                                                      \
+unsigned char USART##n##_available(void);                                                         \
+int USART##n##_read(void);                                                                        \
+unsigned char USART##n##_read_buffer(unsigned char *buffer, unsigned char length);              \
+void USART##n##_get_errors(USART_errors *errors);                                                 \
+void USART##n##_clear_errors(void);                                                               \
+void USART##n##_tx_resume(void);                                                                  \
+void USART##n##_disable(void);
 
 /*
 ***************************************************************************************************
@@ -45,6 +193,10 @@
 #include <avr/io.h>
 #include <util/delay.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
+#include <stdbool.h>
 
 /*
 ***************************************************************************************************
@@ -59,8 +211,15 @@
 **                                      FUNCTION PROTOTYPES
 ***************************************************************************************************
 */
-void USART0_init(void);
-void USART0_send_byte(unsigned char byte_to_send);
+#if USART0_ENABLE
+USART_PROTOTYPES(0)
+#endif
+
+#if USART1_ENABLE
+USART_PROTOTYPES(1)
+#endif
+
+void USART_sleep(void);
 
 
 
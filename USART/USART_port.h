@@ -0,0 +1,602 @@
+/*
+***************************************************************************************************
+* Project:  USART
+* Filename: USART_port.h
+*
+* Created: 18.05.2017
+* Author:  M. Schuepbach
+*
+* Description: Driver code for one USART port. This file is included by USART.c once per enabled
+*              port with USART_N set to the port number (0 or 1). All register, bit and vector
+*              names are pasted together at compile time (e.g. USART_REG(UCSR, A) -> UCSR1A), so
+*              the generated code is the same as hand-written code for that port.
+*
+*              No include guard, this file is meant to be included more than once.
+*
+***************************************************************************************************
+*/
+
+#ifndef USART_N
+#error "Define USART_N before including USART_port.h"
+#endif
+
+
+/*
+***************************************************************************************************
+**                                   SYSTEM DEFINES AND MACROS
+***************************************************************************************************
+*/
+#define USART_PASTE(a, n, b)    a##n##b
+#define USART_XPASTE(a, n, b)   USART_PASTE(a, n, b)
+
+#define USART_FN(name)          USART_XPASTE(USART, USART_N, name)  /* USART_FN(_init) -> USART0_init */
+#define USART_REG(reg, suffix)  USART_XPASTE(reg, USART_N, suffix)  /* USART_REG(UCSR, A) -> UCSR0A  */
+#define USART_BIT(bit)          USART_XPASTE(bit, USART_N, )        /* USART_BIT(RXC) -> RXC0        */
+
+#if USART_FN(_FLOW_CONTROL)
+#define USART_RTS_ASSERT()      (USART_FN(_RTS_PORT) &= ~(1<<USART_FN(_RTS_BIT)))
+#define USART_RTS_RELEASE()     (USART_FN(_RTS_PORT) |= (1<<USART_FN(_RTS_BIT)))
+#define USART_CTS_ASSERTED()    ((USART_FN(_CTS_PIN) & (1<<USART_FN(_CTS_BIT))) == 0)
+#else
+#define USART_RTS_ASSERT()
+#define USART_RTS_RELEASE()
+#define USART_CTS_ASSERTED()    (true)
+#endif
+
+
+/*
+***************************************************************************************************
+**                                  GLOBAL VARIABLES AND ARRAYS
+***************************************************************************************************
+*/
+static volatile unsigned char USART_FN(_tx_buffer)[USART_FN(_TX_BUFFER_SIZE)];
+static volatile unsigned char USART_FN(_tx_head) = 0;      /* Written with interrupts disabled */
+static volatile unsigned char USART_FN(_tx_tail) = 0;      /* Written by the UDRE interrupt only */
+static volatile bool          USART_FN(_tx_written) = false;
+
+static volatile unsigned char USART_FN(_rx_buffer)[USART_FN(_RX_BUFFER_SIZE)];
+static volatile unsigned char USART_FN(_rx_head) = 0;      /* Written by the RX interrupt only */
+static volatile unsigned char USART_FN(_rx_tail) = 0;      /* Written by the application only */
+
+static volatile USART_errors  USART_FN(_errors);           /* Written by the RX interrupt only */
+
+
+/*
+***************************************************************************************************
+**                                           FUNCTIONS
+***************************************************************************************************
+*/
+
+/*
+***************************************************************************************************
+* Function: USARTn_init
+* ---------------------
+*   Initializes USARTn
+*   Settings: Asynchronous, USARTn_BAUD, USARTn_DATA_BITS, USARTn_PARITY, USARTn_STOP_BITS
+*   Turns the USARTn on in PRR, USARTn_disable turns it off again.
+*
+***************************************************************************************************
+*/
+void USART_FN(_init)(void)
+{
+    PRR &= ~(1<<USART_BIT(PRUSART));                    /* Power on, registers are not accessible before */
+    
+    USART_REG(UBRR, H) = (unsigned char)(USART_FN(_BAUDRATE)>>8);     /* Set baud rate */
+    USART_REG(UBRR, L) = (unsigned char)USART_FN(_BAUDRATE);
+    
+    USART_REG(UCSR, A) = (1<<USART_BIT(RXC))|(USART_FN(_USE_2X)<<USART_BIT(U2X));   /* Set Receive Complete flag, needed for interrupt, double speed */
+    USART_REG(UCSR, C) = USART_FRAME(USART_FN(_DATA_BITS), USART_FN(_PARITY), USART_FN(_STOP_BITS));
+    USART_REG(UCSR, B) = (1<<USART_BIT(RXCIE))|(1<<USART_BIT(RXEN))|(1<<USART_BIT(TXEN));  /* Enable Receive Complete Interrupt, receiver and transmitter */
+    
+#if USART_FN(_FLOW_CONTROL)
+    USART_FN(_CTS_DDR) &= ~(1<<USART_FN(_CTS_BIT));    /* CTS as input */
+    USART_FN(_RTS_DDR) |= (1<<USART_FN(_RTS_BIT));     /* RTS as output, ready to receive */
+    USART_RTS_ASSERT();
+#endif
+    
+    sei();
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_tx_next
+* ------------------------
+*   Move the next byte from the transmit buffer into UDRn. Disables the data register empty
+*   interrupt when the buffer is empty. UDRn must be ready (UDREn set) when this is called.
+*
+***************************************************************************************************
+*/
+static void USART_FN(_tx_next)(void)
+{
+    unsigned char tail = USART_FN(_tx_tail);
+    
+    
+    if ((tail == USART_FN(_tx_head)) || !USART_CTS_ASSERTED()) {
+        USART_REG(UCSR, B) &= ~(1<<USART_BIT(UDRIE));   /* Buffer empty or receiver not ready, stop */
+        return;
+    }
+    
+    USART_REG(UCSR, A) = (USART_REG(UCSR, A) & ((1<<USART_BIT(U2X))|(1<<USART_BIT(MPCM)))) | (1<<USART_BIT(TXC));   /* Clear Transmit Complete flag */
+    USART_REG(UDR, ) = USART_FN(_tx_buffer)[tail];                                                                      /* Transmission starts */
+    USART_FN(_tx_tail) = (tail + 1) & USART_FN(_TX_BUFFER_MASK);
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_tx_resume
+* --------------------------
+*   Restart sending after CTS was released and asserted again. Call it from a pin-change ISR on
+*   the CTS pin, the send and flush functions also call it while they wait.
+*   Does nothing without flow control.
+*
+***************************************************************************************************
+*/
+void USART_FN(_tx_resume)(void)
+{
+#if USART_FN(_FLOW_CONTROL)
+    if (USART_CTS_ASSERTED() && (USART_FN(_tx_head) != USART_FN(_tx_tail))) {
+        USART_REG(UCSR, B) |= (1<<USART_BIT(UDRIE));
+    }
+#endif
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_tx_poll
+* ------------------------
+*   Drain the transmit buffer by polling if interrupts are disabled (e.g. when called from
+*   inside an ISR). Otherwise the UDRE interrupt does the work and this does nothing.
+*
+***************************************************************************************************
+*/
+static void USART_FN(_tx_poll)(void)
+{
+    if ( !(SREG & (1<<SREG_I)) && (USART_REG(UCSR, A) & (1<<USART_BIT(UDRE))) ) {
+        USART_FN(_tx_next)();
+    }
+    
+    USART_FN(_tx_resume)();
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_put
+* --------------------
+*   Inline part of USARTn_put_byte, also used by the bulk send functions so they do not pay a
+*   function call per byte.
+*
+***************************************************************************************************
+*/
+static inline bool USART_FN(_put)(unsigned char byte_to_send)
+{
+    unsigned char head;
+    unsigned char next;
+    bool          queued = true;
+    
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {                 /* Senders in main and in ISRs share the head */
+        head = USART_FN(_tx_head);
+        next = (head + 1) & USART_FN(_TX_BUFFER_MASK);
+    
+        if ((head == USART_FN(_tx_tail)) && (USART_REG(UCSR, A) & (1<<USART_BIT(UDRE))) && USART_CTS_ASSERTED()) {    /* Fast path: nothing queued */
+            USART_REG(UCSR, A) = (USART_REG(UCSR, A) & ((1<<USART_BIT(U2X))|(1<<USART_BIT(MPCM)))) | (1<<USART_BIT(TXC));
+            USART_REG(UDR, ) = byte_to_send;
+        } else if (next == USART_FN(_tx_tail)) {
+            queued = false;                             /* Buffer full */
+        } else {
+            USART_FN(_tx_buffer)[head] = byte_to_send;
+            USART_FN(_tx_head) = next;
+    
+            USART_REG(UCSR, B) |= (1<<USART_BIT(UDRIE));    /* Let the UDRE interrupt send it */
+        }
+    }
+    
+    return queued;
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_put_byte
+* -------------------------
+*   Put a byte into the transmit buffer without waiting.
+*   If the buffer is empty and UDRn is ready, the byte is written directly to UDRn.
+*
+*   byte_to_send: Byte that should be sent via USARTn
+*
+*   returns:      true (byte queued) or false (buffer full, byte dropped)
+*
+***************************************************************************************************
+*/
+bool USART_FN(_put_byte)(unsigned char byte_to_send)
+{
+    USART_FN(_tx_written) = true;
+    
+    return USART_FN(_put)(byte_to_send);
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_send_byte
+* --------------------------
+*   Send byte via USARTn. The byte is queued in the transmit buffer, waits only if the buffer
+*   is full. Can also be used from inside an ISR, the bytes of main and ISR senders are then
+*   interleaved byte by byte.
+*
+*   byte_to_send: Byte that should me sent via USARTn
+*
+***************************************************************************************************
+*/
+void USART_FN(_send_byte)(unsigned char byte_to_send)
+{
+    PROFILE_ENTER(USART_FN(_PROFILE_SEND_BYTE));
+    
+    
+    while ( !USART_FN(_put_byte)(byte_to_send) ) {      /* Wait for free space in buffer */
+        USART_FN(_tx_poll)();
+    }
+    
+    PROFILE_EXIT(USART_FN(_PROFILE_SEND_BYTE));
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_send_buffer
+* ----------------------------
+*   Send length bytes from RAM via USARTn. Waits only while the transmit buffer is full.
+*
+*   buffer: bytes to send
+*   length: number of bytes
+*
+***************************************************************************************************
+*/
+void USART_FN(_send_buffer)(const unsigned char *buffer, unsigned int length)
+{
+    USART_FN(_tx_written) = true;
+    
+    while (length--) {
+        while ( !USART_FN(_put)(*buffer) ) {
+            USART_FN(_tx_poll)();
+        }
+        buffer++;
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_send_string
+* ----------------------------
+*   Send a null-terminated string from RAM via USARTn (without the null character).
+*
+*   string: string to send
+*
+***************************************************************************************************
+*/
+void USART_FN(_send_string)(const char *string)
+{
+    char c;
+    
+    
+    USART_FN(_tx_written) = true;
+    
+    while ((c = *string++) != '\0') {
+        while ( !USART_FN(_put)(c) ) {
+            USART_FN(_tx_poll)();
+        }
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_send_P
+* -----------------------
+*   Send a null-terminated string directly from flash via USARTn, nothing is copied to RAM.
+*   Use it with PSTR("...") or a PROGMEM array.
+*
+*   string: string in flash
+*
+***************************************************************************************************
+*/
+void USART_FN(_send_P)(const char *string)
+{
+    char c;
+    
+    
+    USART_FN(_tx_written) = true;
+    
+    while ((c = pgm_read_byte(string++)) != '\0') {
+        while ( !USART_FN(_put)(c) ) {
+            USART_FN(_tx_poll)();
+        }
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_tx_free
+* ------------------------
+*   returns: number of bytes that can be queued without waiting
+*
+***************************************************************************************************
+*/
+unsigned char USART_FN(_tx_free)(void)
+{
+    return (USART_FN(_tx_tail) - USART_FN(_tx_head) - 1) & USART_FN(_TX_BUFFER_MASK);
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_flush
+* ----------------------
+*   Wait until all queued bytes are sent and the last frame has left the shift register.
+*
+***************************************************************************************************
+*/
+void USART_FN(_flush)(void)
+{
+    if ( !USART_FN(_tx_written) ) {
+        return;                                         /* Nothing sent yet, TXCn would never be set */
+    }
+    
+    while (USART_FN(_tx_head) != USART_FN(_tx_tail)) {
+        USART_FN(_tx_poll)();
+    }
+    
+    while ( !(USART_REG(UCSR, A) & (1<<USART_BIT(TXC))) );     /* Wait for Transmit Complete */
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_tx_idle
+* ------------------------
+*   returns: true if nothing is queued and the last frame has left the shift register, the
+*            transmitter does not need the clock any more
+*
+***************************************************************************************************
+*/
+static bool USART_FN(_tx_idle)(void)
+{
+    return (USART_FN(_tx_head) == USART_FN(_tx_tail)) &&
+           (!USART_FN(_tx_written) || (USART_REG(UCSR, A) & (1<<USART_BIT(TXC))));
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_tx_queued
+* --------------------------
+*   returns: true if bytes wait in the transmit buffer, the UDRE interrupt then wakes the CPU
+*            when the next one is sent
+*
+***************************************************************************************************
+*/
+static inline bool USART_FN(_tx_queued)(void)
+{
+    return USART_FN(_tx_head) != USART_FN(_tx_tail);
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_disable
+* ------------------------
+*   Send the queued bytes, then turn USARTn off (receiver, transmitter and PRR). Received bytes
+*   stay in the receive buffer. USARTn_init turns it on again.
+*
+***************************************************************************************************
+*/
+void USART_FN(_disable)(void)
+{
+    USART_FN(_flush)();
+    
+    USART_REG(UCSR, B) = 0;
+    USART_REG(UCSR, D) = 0;
+    PRR |= (1<<USART_BIT(PRUSART));
+    
+    USART_FN(_tx_written) = false;                      /* TXCn is lost with the power */
+    
+#if USART_FN(_FLOW_CONTROL)
+    USART_RTS_RELEASE();                                /* Cannot receive any more */
+#endif
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_available
+* --------------------------
+*   returns: number of received bytes waiting in the receive buffer
+*
+***************************************************************************************************
+*/
+unsigned char USART_FN(_available)(void)
+{
+    return (USART_FN(_rx_head) - USART_FN(_rx_tail)) & USART_FN(_RX_BUFFER_MASK);
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_read
+* ---------------------
+*   Read a byte from the receive buffer.
+*
+*   returns: received byte (0...255) or -1 if the buffer is empty
+*
+***************************************************************************************************
+*/
+int USART_FN(_read)(void)
+{
+    unsigned char tail = USART_FN(_rx_tail);
+    unsigned char byte;
+    
+    
+    if (tail == USART_FN(_rx_head)) {
+        return -1;
+    }
+    
+    byte = USART_FN(_rx_buffer)[tail];
+    USART_FN(_rx_tail) = (tail + 1) & USART_FN(_RX_BUFFER_MASK);  /* Release the slot after reading it */
+    
+#if USART_FN(_FLOW_CONTROL)
+    if (USART_FN(_available)() <= USART_FN(_RX_LOW_WATERMARK)) {
+        USART_RTS_ASSERT();
+    }
+#endif
+    
+    return byte;
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_read_buffer
+* ----------------------------
+*   Read up to length bytes from the receive buffer without waiting.
+*
+*   buffer: destination
+*   length: maximum number of bytes to read
+*
+*   returns: number of bytes read
+*
+***************************************************************************************************
+*/
+unsigned char USART_FN(_read_buffer)(unsigned char *buffer, unsigned char length)
+{
+    unsigned char head = USART_FN(_rx_head);                /* Snapshot, bytes arriving later stay */
+    unsigned char tail = USART_FN(_rx_tail);
+    unsigned char count = 0;
+    
+    
+    while ((tail != head) && (count < length)) {
+        buffer[count++] = USART_FN(_rx_buffer)[tail];
+        tail = (tail + 1) & USART_FN(_RX_BUFFER_MASK);
+    }
+    
+    USART_FN(_rx_tail) = tail;
+    
+#if USART_FN(_FLOW_CONTROL)
+    if (USART_FN(_available)() <= USART_FN(_RX_LOW_WATERMARK)) {
+        USART_RTS_ASSERT();
+    }
+#endif
+    
+    return count;
+}
+
+
+/*
+***************************************************************************************************
+* Function: USARTn_get_errors
+* ---------------------------
+*   Copy the error counters of USARTn.
+*
+*   errors: destination
+*
+***************************************************************************************************
+*/
+void USART_FN(_get_errors)(USART_errors *errors)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {                 /* 16 bit counters, written by the ISR */
+        errors->overrun = USART_FN(_errors).overrun;
+        errors->framing = USART_FN(_errors).framing;
+        errors->parity  = USART_FN(_errors).parity;
+        errors->dropped = USART_FN(_errors).dropped;
+    }
+}
+
+/*
+***************************************************************************************************
+* Function: USARTn_clear_errors
+* -----------------------------
+*   Reset the error counters of USARTn.
+*
+***************************************************************************************************
+*/
+void USART_FN(_clear_errors)(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        USART_FN(_errors).overrun = 0;
+        USART_FN(_errors).framing = 0;
+        USART_FN(_errors).parity  = 0;
+        USART_FN(_errors).dropped = 0;
+    }
+}
+
+/*
+***************************************************************************************************
+* Interrupt vector for USARTn Data Register Empty
+* -----------------------------------------------
+*
+***************************************************************************************************
+*/
+ISR (USART_FN(_UDRE_vect))
+{
+    USART_FN(_tx_next)();
+}
+
+/*
+***************************************************************************************************
+* Interrupt vector for USARTn Receive Start
+* -----------------------------------------
+*   Start bit detected while the CPU was in Power-down (see USART_sleep). Only used to wake up,
+*   the frame itself is received as usual. Start frame detection is turned off until the next
+*   sleep, it would interrupt every frame otherwise.
+*
+***************************************************************************************************
+*/
+ISR (USART_FN(_START_vect))
+{
+    USART_REG(UCSR, D) = (1<<USART_BIT(RXS));           /* Clear flag, RXSIEn and SFDEn off */
+}
+
+/*
+***************************************************************************************************
+* Interrupt vector for USARTn Receive Complete
+* --------------------------------------------
+*   Stores the received byte in the receive buffer and counts receive errors. Bytes with a frame
+*   or parity error and bytes that do not fit into the buffer are dropped. With flow control,
+*   RTS is released when the buffer reaches the high watermark.
+*
+***************************************************************************************************
+*/
+ISR (USART_FN(_RX_vect))
+{
+    unsigned char status = USART_REG(UCSR, A);          /* Must be read before UDRn */
+    unsigned char byte = USART_REG(UDR, );
+    unsigned char head = USART_FN(_rx_head);
+    unsigned char next = (head + 1) & USART_FN(_RX_BUFFER_MASK);
+    PROFILE_ENTER(USART_FN(_PROFILE_RX));
+    
+    
+    if (status & (1<<USART_BIT(DOR))) {
+        USART_FN(_errors).overrun++;
+    }
+    
+    if (status & (1<<USART_BIT(FE))) {
+        USART_FN(_errors).framing++;
+    } else if (status & (1<<USART_BIT(UPE))) {
+        USART_FN(_errors).parity++;
+    } else if (next != USART_FN(_rx_tail)) {
+        USART_FN(_rx_buffer)[head] = byte;
+        USART_FN(_rx_head) = next;
+    } else {
+        USART_FN(_errors).dropped++;
+    }
+    
+    if (status & ((1<<USART_BIT(DOR))|(1<<USART_BIT(FE))|(1<<USART_BIT(UPE)))) {
+        TRACE2(TRACE_USART_RX_ERROR, USART_N, status);
+    }
+    
+#if USART_FN(_FLOW_CONTROL)
+    if (USART_FN(_available)() >= USART_FN(_RX_HIGH_WATERMARK)) {
+        USART_RTS_RELEASE();
+    }
+#endif
+    
+    PROFILE_EXIT(USART_FN(_PROFILE_RX));
+}
+
+
+#undef USART_PASTE
+#undef USART_XPASTE
+#undef USART_FN
+#undef USART_REG
+#undef USART_BIT
+#undef USART_RTS_ASSERT
+#undef USART_RTS_RELEASE
+#undef USART_CTS_ASSERTED
@@ -7,7 +7,7 @@
 * Author:  M. Schuepbach
 *
 * Description: This is a test program for the USART Driver.
-*              Look into the ISR vector for the example.
+*              Look into the Main loop for the example.
 *              Tested with ATtiny841 and SparkFun Bluetooth Mate Silver
 *
 ***************************************************************************************************
@@ -15,6 +15,7 @@
 
 #include "main.h"
 #include "USART.h"
+#include "Profile.h"
 
 
 /*
@@ -34,16 +35,28 @@ int main(void)
 {
     /* Local variables */
     volatile unsigned char test = 0;    /* for debugging */
+    int byte;
     
     /* Initializations */
     ATtiny841_board_init();
     USART0_init();
+    PROFILE_init();                     /* Only with PROFILE_ENABLE 1 */
     
+    USART0_send_P(PSTR("ATtiny841 USART test\r\n"));     /* Banner is sent directly from flash */
     
     /* Main loop */
     while(1)
     {
+        while (USART0_available()) {
+            byte = USART0_read();
+            if (PROFILE_ENABLE && (byte == PROFILE_REQUEST)) {
+                PROFILE_dump();                 /* Timing report, see Host/profile_tool */
+            } else {
+                USART0_send_byte(byte);         /* for debugging, just send the received bytes back */
+            }
+        }
         
+        USART_sleep();                          /* Until the next byte arrives or is sent */
         
     } /* while(1) */
 } /* Main */
@@ -60,6 +73,7 @@ int main(void)
 * Function: ATtiny841_board_init
 * ------------------------------
 *   Initializes the ports of the ATtiny841-board
+*   All peripherals are turned off, the drivers turn on what they use
 *
 ***************************************************************************************************
 */
@@ -73,16 +87,8 @@ void ATtiny841_board_init(void)
             
     PORTA = 0b00000000;
     PORTB = 0b00000000;
-}
-
-/*
-***************************************************************************************************
-* Interrupt vector for USART0
-* ---------------------------
-*
-***************************************************************************************************
-*/
-ISR (USART0_RX_vect)
-{
-    USART0_send_byte(UDR0);     /* for debugging, just send the received byte back */
+    
+    PRR = (1<<PRTWI)|(1<<PRUSART1)|(1<<PRUSART0)|(1<<PRSPI)|(1<<PRTIM2)|(1<<PRTIM1)|(1<<PRTIM0)|(1<<PRADC);
+    ACSR0A = (1<<ACD0);                 /* Analog comparators off */
+    ACSR1A = (1<<ACD1);
 }